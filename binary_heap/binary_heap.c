@@ -14,9 +14,9 @@
  * @param capacity maximum number of nodes that the heap can hold
  * @return pointer to the heap 
  */ 
-bheap_t* bh_create(unsigned long capacity)
+bheap_t* bh_create(index_t capacity)
 {
-    unsigned long i;
+    index_t i;
 
     bheap_t* heap = (bheap_t*)malloc(sizeof(bheap_t));
     if ( !heap ) {
@@ -146,12 +146,12 @@ void bh_max_heapify(bheap_t *heap, index_t root)
  */
 void bh_build_min_heap(bheap_t *heap)
 {
-    unsigned long half = heap->capacity >> 1;
+    index_t half = heap->capacity >> 1;
     long int i;
 
     heap->curr_size = heap->capacity;
 
-    for ( i = half-1; i >= 0; i-- )
+    for ( i = (long int)half - 1; i >= 0; i-- )
         bh_min_heapify(heap, i);
 }
 
@@ -161,12 +161,12 @@ void bh_build_min_heap(bheap_t *heap)
  */
 void bh_build_max_heap(bheap_t *heap)
 {
-    unsigned long half = heap->capacity >> 1;
+    index_t half = heap->capacity >> 1;
     long int i;
 
     heap->curr_size = heap->capacity;
     
-    for ( i = half-1; i >= 0; i-- )
+    for ( i = (long int)half - 1; i >= 0; i-- )
         bh_max_heapify(heap, i);
 }
 
@@ -199,9 +199,9 @@ bh_node_t* bh_extract_min(bheap_t *heap)
  * @param value node->value of the node that we want to decrease
  * @param newkey new node value
  */ 
-void bh_decrease_key(bheap_t *heap, unsigned long value, bh_key_t newkey)
+void bh_decrease_key(bheap_t *heap, index_t value, bh_key_t newkey)
 {
-    unsigned long i;
+    index_t i;
     bh_node_t *a = heap->node_array;
     index_t node = heap->where_in_heap[value];
 
@@ -227,7 +227,7 @@ void bh_decrease_key(bheap_t *heap, unsigned long value, bh_key_t newkey)
  */ 
 void bh_min_insert(bheap_t *heap, bh_node_t *node)
 {
-    unsigned long i;
+    index_t i;
     bh_node_t *a = heap->node_array;
         
     heap->curr_size++;
@@ -248,10 +248,10 @@ void bh_min_insert(bheap_t *heap, bh_node_t *node)
  */ 
 void bh_print(bheap_t *heap)
 {
-    unsigned long i;
+    index_t i;
 
     for ( i = 0; i < heap->curr_size; i++ )
-        fprintf(stdout, "<%f,%lu>(where:%lu) ", 
+        fprintf(stdout, "<%f,%" PRIvid ">(where:%" PRIvid ") ", 
                 heap->node_array[i].key,
                 heap->node_array[i].value, 
                 heap->where_in_heap[heap->node_array[i].value]);
@@ -264,7 +264,7 @@ void bh_print(bheap_t *heap)
  */ 
 void bh_print_keys(bheap_t *heap)
 {
-    unsigned long i;
+    index_t i;
 
     for ( i = 0; i < heap->curr_size; i++ )
         fprintf(stdout, "%f ", heap->node_array[i].key);
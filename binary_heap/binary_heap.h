@@ -6,15 +6,18 @@
 #ifndef BHEAP_H_
 #define BHEAP_H_
 
+#include "graph/graph.h"
+
 /**
  * Node key data type
  */ 
 typedef float bh_key_t;
 
 /**
- * Node index data type
+ * Node index data type. Heap values are vertex ids, so this follows 
+ * the vertex id width of the graph (see graph/graph.h).
  */ 
-typedef unsigned long index_t;
+typedef vid_t index_t;
 
  
 /**
@@ -22,15 +25,15 @@ typedef unsigned long index_t;
  */ 
 typedef struct bh_node_st {
     bh_key_t key; //!< key ("weight") of the node (not unique)
-    unsigned long value; //!< data associated with the node (unique)
+    index_t value; //!< data associated with the node (unique)
 } bh_node_t;
 
 /**
  * Heap data structure
  */ 
 typedef struct bheap_st {
-    unsigned long capacity; //!< maximum nodes the heap can hold
-    unsigned long curr_size; //!< heap current size
+    index_t capacity; //!< maximum nodes the heap can hold
+    index_t curr_size; //!< heap current size
     bh_node_t *node_array; //!< array of heap nodes
     index_t *where_in_heap; //!< array that tells the current position 
                             //!< in the heap of a node given its value
@@ -67,7 +70,7 @@ static inline index_t bh_right(index_t i)
     return ((i<<1)+2);
 }
  
-extern bheap_t* bh_create(unsigned long capacity);
+extern bheap_t* bh_create(index_t capacity);
 extern void bh_destroy(bheap_t *heap);
 extern void bh_min_heapify(bheap_t *heap, index_t root);
 extern void bh_max_heapify(bheap_t *heap, index_t root);
@@ -77,6 +80,6 @@ extern bh_node_t* bh_extract_min(bheap_t *heap);
 extern void bh_print_keys(bheap_t *heap);
 extern void bh_print(bheap_t *heap);
 extern void bh_min_insert(bheap_t *heap, bh_node_t *node);
-extern void bh_decrease_key(bheap_t *heap, unsigned long value, bh_key_t newkey);
+extern void bh_decrease_key(bheap_t *heap, index_t value, bh_key_t newkey);
 
 #endif
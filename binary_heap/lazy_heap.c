@@ -0,0 +1,111 @@
+/**
+ * @file
+ * Push-only binary heap function definitions
+ */ 
+
+#include "lazy_heap.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * Allocates an empty heap
+ * @param capacity initial number of nodes that the heap can hold
+ * @return pointer to the heap 
+ */ 
+lheap_t* lh_create(eid_t capacity)
+{
+    lheap_t* heap = (lheap_t*)malloc(sizeof(lheap_t));
+    if ( !heap ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+
+    heap->capacity = capacity > 0 ? capacity : 16;
+    heap->curr_size = 0;
+    heap->node_array = (bh_node_t*)malloc(heap->capacity * sizeof(bh_node_t));
+    if ( !heap->node_array ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+
+    return heap;
+}
+
+/**
+ * Deallocates heap
+ * @param heap pointer to heap
+ */ 
+void lh_destroy(lheap_t *heap)
+{
+    free(heap->node_array);
+    free(heap);
+} 
+
+/**
+ * Inserts a node, doubling the heap capacity when full
+ * @param heap pointer to the heap
+ * @param value node value (need not be unique)
+ * @param key node key
+ */ 
+void lh_push(lheap_t *heap, index_t value, bh_key_t key)
+{
+    eid_t i, p;
+    bh_node_t *a;
+
+    if ( heap->curr_size == heap->capacity ) {
+        heap->capacity *= 2;
+        heap->node_array = (bh_node_t*)realloc(heap->node_array, 
+                                    heap->capacity * sizeof(bh_node_t));
+        if ( !heap->node_array ) {
+            fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // Move the hole up from the end
+    a = heap->node_array;
+    i = heap->curr_size++;
+    while ( i > 0 ) {
+        p = (i-1) >> 1;
+        if ( a[p].key <= key )
+            break;
+        a[i] = a[p];
+        i = p;
+    }
+    a[i].key = key;
+    a[i].value = value;
+}
+
+/**
+ * Removes a node with minimum key
+ * @param heap pointer to the heap (must not be empty)
+ * @param key key of the removed node (output)
+ * @return value of the removed node
+ */ 
+index_t lh_pop(lheap_t *heap, bh_key_t *key)
+{
+    eid_t i, c, n;
+    bh_node_t *a = heap->node_array, last;
+    index_t min = a[0].value;
+
+    *key = a[0].key;
+    n = --heap->curr_size;
+    if ( n == 0 )
+        return min;
+
+    // Move the hole down from the root, then fill it with the last node
+    last = a[n];
+    i = 0;
+    while ( (c = (i<<1)+1) < n ) {
+        if ( c+1 < n && a[c+1].key < a[c].key )
+            c++;
+        if ( last.key <= a[c].key )
+            break;
+        a[i] = a[c];
+        i = c;
+    }
+    a[i] = last;
+
+    return min;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file
+ * Push-only binary heap type definitions and function declarations.
+ *
+ * Unlike bheap_t, the heap holds no position index and starts empty.
+ * An id may be pushed several times with different keys; callers 
+ * that only need the smallest key of each id (e.g. Dijkstra's 
+ * algorithm) skip the stale entries as they are popped. Memory is 
+ * proportional to the number of entries pushed, not to the number of 
+ * possible ids.
+ */ 
+
+#ifndef LHEAP_H_
+#define LHEAP_H_
+
+#include "binary_heap.h"
+
+/**
+ * Heap data structure
+ */ 
+typedef struct lheap_st {
+    eid_t capacity; //!< allocated nodes (grows on demand)
+    eid_t curr_size; //!< heap current size
+    bh_node_t *node_array; //!< array of heap nodes
+} lheap_t;
+
+/**
+ * Returns whether the heap is empty
+ * @param heap pointer to the heap
+ * @return 1 if empty, 0 otherwise
+ */ 
+static inline int lh_empty(const lheap_t *heap)
+{
+    return heap->curr_size == 0;
+}
+
+/**
+ * Returns the smallest key in the heap
+ * @param heap pointer to the heap (must not be empty)
+ * @return smallest key
+ */ 
+static inline bh_key_t lh_top_key(const lheap_t *heap)
+{
+    return heap->node_array[0].key;
+}
+
+/**
+ * Empties the heap, keeping its memory for reuse
+ * @param heap pointer to the heap
+ */ 
+static inline void lh_clear(lheap_t *heap)
+{
+    heap->curr_size = 0;
+}
+
+extern lheap_t* lh_create(eid_t capacity);
+extern void lh_destroy(lheap_t *heap);
+extern void lh_push(lheap_t *heap, index_t value, bh_key_t key);
+extern index_t lh_pop(lheap_t *heap, bh_key_t *key);
+
+#endif
@@ -0,0 +1,50 @@
+/**
+ * @file
+ * Push-only binary heap test program
+ */ 
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "lazy_heap.h"
+
+#define N 100000
+
+int main(int argc, char **argv)
+{
+    lheap_t *heap = lh_create(1);
+    bh_key_t key, prev;
+    index_t i, value, n;
+
+    // Duplicate values and growth from a tiny initial capacity
+    srand(1);
+    for ( i = 0; i < N; i++ )
+        lh_push(heap, i % 100, rand() % 1000);
+    assert(heap->curr_size == N);
+
+    prev = 0;
+    for ( n = 0; !lh_empty(heap); n++ ) {
+        value = lh_pop(heap, &key);
+        assert(value < 100);
+        assert(key >= prev);
+        prev = key;
+
+        // Pushes of larger keys while popping, as in Dijkstra
+        if ( n % 2 == 0 && n < N )
+            lh_push(heap, value, key + rand() % 1000);
+    }
+    assert(n == N + N / 2);
+
+    lh_clear(heap);
+    lh_push(heap, 3, 2.5);
+    lh_push(heap, 4, 1.5);
+    assert(lh_pop(heap, &key) == 4 && key == 1.5);
+    assert(lh_pop(heap, &key) == 3 && key == 2.5);
+    assert(lh_empty(heap));
+
+    fprintf(stdout, "Push-only heap: OK\n");
+
+    lh_destroy(heap);
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file
+ * Bucket queue function definitions
+ */ 
+
+#include "bucket_queue.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * Allocates an empty bucket queue
+ * @param span largest difference between a pushed key and the last 
+ *             popped key
+ * @return pointer to the queue 
+ */ 
+bqueue_t* bq_create(uint32_t span)
+{
+    bqueue_t *q = (bqueue_t*)calloc(1, sizeof(bqueue_t));
+    if ( !q || span == UINT32_MAX ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+
+    q->nbuckets = span + 1;
+    q->buckets = (bq_bucket_t*)calloc(q->nbuckets, sizeof(bq_bucket_t));
+    if ( !q->buckets ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+
+    return q;
+}
+
+/**
+ * Deallocates queue
+ * @param q pointer to queue
+ */ 
+void bq_destroy(bqueue_t *q)
+{
+    uint32_t i;
+
+    for ( i = 0; i < q->nbuckets; i++ )
+        free(q->buckets[i].ids);
+    free(q->buckets);
+    free(q);
+}
+
+/**
+ * Empties the queue and resets the last popped key to 0, keeping the
+ * bucket memory for reuse
+ * @param q pointer to queue
+ */ 
+void bq_clear(bqueue_t *q)
+{
+    uint32_t i;
+
+    for ( i = 0; i < q->nbuckets; i++ )
+        q->buckets[i].size = 0;
+    q->size = 0;
+    q->curr = 0;
+    q->curr_bucket = 0;
+}
+
+/**
+ * Doubles the capacity of a full bucket (called by bq_push())
+ * @param b bucket
+ */ 
+void bq_grow(bq_bucket_t *b)
+{
+    b->capacity = b->capacity ? 2 * b->capacity : 16;
+    b->ids = (vid_t*)realloc(b->ids, b->capacity * sizeof(vid_t));
+    if ( !b->ids ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * Removes an entry with minimum key
+ * @param q pointer to queue (must not be empty)
+ * @param key key of the removed entry (output)
+ * @return data of the removed entry
+ */ 
+vid_t bq_pop(bqueue_t *q, bq_key_t *key)
+{
+    bq_bucket_t *b;
+
+    // Walk the circle up to the next non-empty bucket; all keys lie
+    // within one turn of the current one
+    while ( q->buckets[q->curr_bucket].size == 0 ) {
+        q->curr++;
+        if ( ++q->curr_bucket == q->nbuckets )
+            q->curr_bucket = 0;
+    }
+
+    b = &q->buckets[q->curr_bucket];
+    b->size--;
+    q->size--;
+    *key = q->curr;
+
+    return b->ids[b->size];
+}
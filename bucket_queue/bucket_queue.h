@@ -0,0 +1,88 @@
+/**
+ * @file
+ * Bucket queue type definitions and function declarations.
+ *
+ * Monotone priority queue for small integer keys (Dial's algorithm):
+ * if every key pushed lies in [c, c + span], where c is the last key
+ * popped, the queue only ever holds span + 1 distinct keys, and a 
+ * circular array of span + 1 buckets, one per key, indexed by the key 
+ * modulo span + 1, keeps them apart. Popping scans forward from the 
+ * bucket of the last key to the first non-empty one, so a whole 
+ * Dijkstra run with integer weights at most span costs O(m + n span).
+ *
+ * There is no decrease-key: a key is lowered by pushing the id again, 
+ * and stale entries are skipped by the caller.
+ */ 
+
+#ifndef BQUEUE_H_
+#define BQUEUE_H_
+
+#include <stdint.h>
+
+#include "graph/graph.h"
+
+/**
+ * Key data type
+ */ 
+typedef uint64_t bq_key_t;
+
+/**
+ * Bucket of ids sharing a key, in no particular order
+ */ 
+typedef struct bq_bucket_st {
+    vid_t *ids; //!< ids (not unique)
+    eid_t size; //!< number of ids
+    eid_t capacity; //!< allocated ids
+} bq_bucket_t;
+
+/**
+ * Queue data structure
+ */ 
+typedef struct bqueue_st {
+    bq_bucket_t *buckets; //!< circular array of buckets
+    uint32_t nbuckets; //!< number of buckets (span + 1)
+    uint32_t curr_bucket; //!< bucket of the current key
+    bq_key_t curr; //!< last popped key
+    eid_t size; //!< number of ids in all buckets
+} bqueue_t;
+
+/**
+ * Returns whether the queue is empty
+ * @param q pointer to queue
+ * @return 1 if empty, 0 otherwise
+ */ 
+static inline int bq_empty(const bqueue_t *q)
+{
+    return q->size == 0;
+}
+
+extern bqueue_t* bq_create(uint32_t span);
+extern void bq_destroy(bqueue_t *q);
+extern void bq_clear(bqueue_t *q);
+extern void bq_grow(bq_bucket_t *b);
+
+/**
+ * Inserts an entry
+ * @param q pointer to queue
+ * @param key entry key (between the last popped key and that plus 
+ *            the span)
+ * @param id entry data
+ */ 
+static inline void bq_push(bqueue_t *q, bq_key_t key, vid_t id)
+{
+    uint32_t i;
+    bq_bucket_t *b;
+
+    i = q->curr_bucket + (uint32_t)(key - q->curr);
+    if ( i >= q->nbuckets )
+        i -= q->nbuckets;
+    b = &q->buckets[i];
+    if ( b->size == b->capacity )
+        bq_grow(b);
+    b->ids[b->size++] = id;
+    q->size++;
+}
+
+extern vid_t bq_pop(bqueue_t *q, bq_key_t *key);
+
+#endif
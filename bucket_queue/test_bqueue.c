@@ -0,0 +1,68 @@
+/**
+ * @file
+ * Bucket queue test program
+ */ 
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bucket_queue.h"
+
+#define N 100000
+#define SPAN 1000
+
+int main(int argc, char **argv)
+{
+    bqueue_t *q = bq_create(SPAN);
+    bq_key_t key, prev;
+    vid_t id, n;
+    eid_t *count;
+
+    // Keys within the span of the last popped key, interleaving pops 
+    // with pushes so that the circle wraps around many times
+    srand(1);
+    for ( id = 0; id < N / 2; id++ )
+        bq_push(q, rand() % (SPAN + 1), id);
+    prev = 0;
+    for ( n = 0; !bq_empty(q); n++ ) {
+        bq_pop(q, &key);
+        assert(key >= prev);
+        prev = key;
+        if ( n < N / 2 )
+            bq_push(q, key + rand() % (SPAN + 1), n);
+    }
+    assert(n == N);
+    assert(prev > SPAN);
+
+    // Every id comes back with its key, the ends of the span included
+    bq_clear(q);
+    count = (eid_t*)calloc(SPAN + 1, sizeof(eid_t));
+    for ( id = 0; id < N; id++ ) {
+        key = id % 3 == 0 ? SPAN : (id % 3 == 1 ? 0 : rand() % (SPAN + 1));
+        bq_push(q, key, id);
+        count[key]++;
+    }
+    for ( n = 0; !bq_empty(q); n++ ) {
+        id = bq_pop(q, &key);
+        assert(key <= SPAN && count[key] > 0);
+        assert(id % 3 != 0 || key == SPAN);
+        assert(id % 3 != 1 || key == 0);
+        count[key]--;
+    }
+    assert(n == N);
+    free(count);
+
+    // No span: a single bucket, keys equal to the last popped one
+    bq_destroy(q);
+    q = bq_create(0);
+    bq_push(q, 0, 1);
+    bq_push(q, 0, 2);
+    assert(bq_pop(q, &key) == 2 && key == 0);
+    assert(bq_pop(q, &key) == 1 && key == 0 && bq_empty(q));
+
+    fprintf(stdout, "Bucket queue: OK\n");
+
+    bq_destroy(q);
+
+    return 0;
+}
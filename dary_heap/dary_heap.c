@@ -0,0 +1,211 @@
+/**
+ * @file
+ * d-ary heap function definitions
+ */ 
+
+#include "dary_heap.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * Allocates an empty d-ary heap
+ * @param capacity maximum number of nodes that the heap can hold
+ * @return pointer to the heap 
+ */ 
+dheap_t* dh_create(dh_index_t capacity)
+{
+    dh_index_t i;
+
+    dheap_t* heap = (dheap_t*)malloc(sizeof(dheap_t));
+    if ( !heap ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+
+    heap->keys = (dh_key_t*)malloc(capacity * sizeof(dh_key_t));
+    heap->ids = (dh_index_t*)malloc(capacity * sizeof(dh_index_t));
+    heap->where_in_heap = (dh_index_t*)malloc(capacity * sizeof(dh_index_t));
+    if ( !heap->keys || !heap->ids || !heap->where_in_heap ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+
+    heap->capacity = capacity;
+    heap->curr_size = 0;
+
+    for ( i = 0; i < capacity; i++ ) 
+        heap->where_in_heap[i] = DHEAP_NONE;
+
+    return heap;
+}
+
+/**
+ * Deallocates heap
+ * @param heap pointer to heap
+ */ 
+void dh_destroy(dheap_t *heap)
+{
+    free(heap->where_in_heap);
+    free(heap->ids);
+    free(heap->keys);
+    free(heap);
+} 
+
+/**
+ * Moves a node up from position i until its parent has a smaller key,
+ * shifting larger parents down into the hole
+ * @param heap pointer to the heap
+ * @param i current position of the node
+ * @param id node id
+ * @param key node key
+ */ 
+static inline void dh_sift_up(dheap_t *heap, 
+                              dh_index_t i, 
+                              dh_index_t id, 
+                              dh_key_t key)
+{
+    dh_index_t p;
+    dh_key_t *keys = heap->keys;
+    dh_index_t *ids = heap->ids;
+
+    while ( i > 0 ) {
+        p = dh_parent(i);
+        if ( keys[p] <= key )
+            break;
+        keys[i] = keys[p];
+        ids[i] = ids[p];
+        heap->where_in_heap[ids[i]] = i;
+        i = p;
+    }
+
+    keys[i] = key;
+    ids[i] = id;
+    heap->where_in_heap[id] = i;
+}
+
+/**
+ * Moves a node down from position i until its children have larger 
+ * keys, shifting the smallest child up into the hole
+ * @param heap pointer to the heap
+ * @param i current position of the node
+ * @param id node id
+ * @param key node key
+ */ 
+static inline void dh_sift_down(dheap_t *heap, 
+                                dh_index_t i, 
+                                dh_index_t id, 
+                                dh_key_t key)
+{
+    dh_index_t c, end, best, n = heap->curr_size;
+    dh_key_t bestkey;
+    dh_key_t *keys = heap->keys;
+    dh_index_t *ids = heap->ids;
+
+    while ( (c = dh_first_child(i)) < n ) {
+        end = c + DHEAP_ARITY < n ? c + DHEAP_ARITY : n;
+        best = c;
+        bestkey = keys[c];
+        for ( c++; c < end; c++ ) {
+            if ( keys[c] < bestkey ) {
+                best = c;
+                bestkey = keys[c];
+            }
+        }
+        if ( key <= bestkey )
+            break;
+        keys[i] = bestkey;
+        ids[i] = ids[best];
+        heap->where_in_heap[ids[i]] = i;
+        i = best;
+    }
+
+    keys[i] = key;
+    ids[i] = id;
+    heap->where_in_heap[id] = i;
+}
+
+/**
+ * Fills the heap with all ids in [0,capacity), all with the same key
+ * @param heap pointer to the heap
+ * @param key key of every node
+ */ 
+void dh_fill(dheap_t *heap, dh_key_t key)
+{
+    dh_index_t i;
+
+    for ( i = 0; i < heap->capacity; i++ ) {
+        heap->keys[i] = key;
+        heap->ids[i] = i;
+        heap->where_in_heap[i] = i;
+    }
+    heap->curr_size = heap->capacity;
+}
+
+/**
+ * Inserts a node to the heap
+ * @param heap pointer to the heap
+ * @param id node id (must not be in the heap)
+ * @param key node key
+ */ 
+void dh_insert(dheap_t *heap, dh_index_t id, dh_key_t key)
+{
+    heap->curr_size++;
+    dh_sift_up(heap, heap->curr_size-1, id, key);
+}
+
+/**
+ * Performs a decrease key operation on a given node
+ * @param heap pointer to the heap
+ * @param id id of the node that we want to decrease
+ * @param newkey new node key
+ */ 
+void dh_decrease_key(dheap_t *heap, dh_index_t id, dh_key_t newkey)
+{
+    dh_index_t i = heap->where_in_heap[id];
+
+    if ( newkey >= heap->keys[i] ) {
+        fprintf(stderr, "New key (%f) is larger than current key (%f)\n", 
+                newkey, heap->keys[i]);
+        exit(EXIT_FAILURE);
+    }
+
+    dh_sift_up(heap, i, id, newkey);
+}
+
+/**
+ * Extracts the minimum node from the heap
+ * @param heap pointer to the heap (must not be empty)
+ * @param key key of the extracted node (output)
+ * @return id of the extracted node
+ */ 
+dh_index_t dh_extract_min(dheap_t *heap, dh_key_t *key)
+{
+    dh_index_t min = heap->ids[0], last;
+
+    *key = heap->keys[0];
+    heap->where_in_heap[min] = DHEAP_NONE;
+
+    // The last node fills the hole left at the root
+    last = --heap->curr_size;
+    if ( last > 0 )
+        dh_sift_down(heap, 0, heap->ids[last], heap->keys[last]);
+
+    return min;
+}
+
+/**
+ * Prints all key, id pairs of the heap
+ * @param heap pointer to the heap
+ */ 
+void dh_print(dheap_t *heap)
+{
+    dh_index_t i;
+
+    for ( i = 0; i < heap->curr_size; i++ )
+        fprintf(stdout, "<%f,%" PRIvid ">(where:%" PRIvid ") ", 
+                heap->keys[i],
+                heap->ids[i], 
+                heap->where_in_heap[heap->ids[i]]);
+    fprintf(stdout, "\n");
+}
@@ -0,0 +1,102 @@
+/**
+ * @file
+ * d-ary heap type definitions and function declarations.
+ *
+ * Indexed min-heap of vertex ids with a structure-of-arrays layout:
+ * keys and ids live in separate arrays, so that comparing the children
+ * of a node reads one contiguous run of keys. Sifting moves a hole 
+ * down (or up) the tree and writes each moved entry and its position 
+ * once, instead of swapping pairs of nodes.
+ */ 
+
+#ifndef DHEAP_H_
+#define DHEAP_H_
+
+#include "graph/graph.h"
+
+/**
+ * Heap arity (number of children per node), fixed at compile time
+ */ 
+#ifndef DHEAP_ARITY
+#define DHEAP_ARITY 4
+#endif
+
+/**
+ * Node key data type
+ */ 
+typedef float dh_key_t;
+
+/**
+ * Node index data type, follows the vertex id width
+ */ 
+typedef vid_t dh_index_t;
+
+/**
+ * Position of ids that are not in the heap
+ */ 
+#define DHEAP_NONE VID_MAX
+
+/**
+ * Heap data structure
+ */ 
+typedef struct dheap_st {
+    dh_index_t capacity; //!< maximum nodes the heap can hold (ids are 
+                         //!< in [0,capacity))
+    dh_index_t curr_size; //!< heap current size
+    dh_key_t *keys; //!< key of the node at each heap position
+    dh_index_t *ids; //!< id of the node at each heap position
+    dh_index_t *where_in_heap; //!< current position of each id in the 
+                               //!< heap, or DHEAP_NONE
+} dheap_t;
+
+/**
+ * Returns the parent of a node
+ * @param i index of the node
+ * @return index of the parent of the node
+ */
+static inline dh_index_t dh_parent(dh_index_t i)
+{
+    return (i-1) / DHEAP_ARITY;
+} 
+
+/**
+ * Returns the first child of a node
+ * @param i index of the node
+ * @return index of the first child of the node
+ */ 
+static inline dh_index_t dh_first_child(dh_index_t i)
+{
+    return i * DHEAP_ARITY + 1;
+}
+
+/**
+ * Returns whether an id is in the heap
+ * @param heap pointer to the heap
+ * @param id node id
+ * @return 1 if the id is in the heap, 0 otherwise
+ */ 
+static inline int dh_contains(const dheap_t *heap, dh_index_t id)
+{
+    return heap->where_in_heap[id] != DHEAP_NONE;
+}
+
+/**
+ * Returns the key of an id in the heap
+ * @param heap pointer to the heap
+ * @param id node id (must be in the heap)
+ * @return key of the id
+ */ 
+static inline dh_key_t dh_key(const dheap_t *heap, dh_index_t id)
+{
+    return heap->keys[heap->where_in_heap[id]];
+}
+
+extern dheap_t* dh_create(dh_index_t capacity);
+extern void dh_destroy(dheap_t *heap);
+extern void dh_fill(dheap_t *heap, dh_key_t key);
+extern void dh_insert(dheap_t *heap, dh_index_t id, dh_key_t key);
+extern void dh_decrease_key(dheap_t *heap, dh_index_t id, dh_key_t newkey);
+extern dh_index_t dh_extract_min(dheap_t *heap, dh_key_t *key);
+extern void dh_print(dheap_t *heap);
+
+#endif
@@ -0,0 +1,65 @@
+/**
+ * @file
+ * d-ary heap test program
+ */ 
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "dary_heap.h"
+
+#define N 10000
+
+int main(int argc, char **argv)
+{
+    dheap_t *heap = dh_create(N);
+    dh_key_t key, prev, ref[N];
+    dh_index_t i, id, n;
+
+    // Insert all ids, with random keys
+    srand(1);
+    for ( i = 0; i < N; i++ ) {
+        ref[i] = rand() % 1000;
+        dh_insert(heap, i, ref[i]);
+    }
+    assert(heap->curr_size == N);
+
+    // Decrease a random subset of keys
+    for ( i = 0; i < N; i++ ) {
+        id = rand() % N;
+        if ( ref[id] > 0 ) {
+            ref[id] -= 1 + rand() % (int)ref[id];
+            dh_decrease_key(heap, id, ref[id]);
+        }
+        assert(dh_key(heap, id) == ref[id]);
+    }
+
+    // Extraction yields every id once, by non-decreasing key
+    prev = 0;
+    for ( n = 0; heap->curr_size > 0; n++ ) {
+        id = dh_extract_min(heap, &key);
+        assert(key == ref[id]);
+        assert(key >= prev);
+        assert(!dh_contains(heap, id));
+        ref[id] = -1;
+        prev = key;
+    }
+    assert(n == N);
+
+    // Filled heap: the source goes first, ties come out in any order
+    dh_fill(heap, 1000);
+    dh_decrease_key(heap, 7, 0);
+    id = dh_extract_min(heap, &key);
+    assert(id == 7 && key == 0);
+    for ( n = 1; heap->curr_size > 0; n++ ) {
+        dh_extract_min(heap, &key);
+        assert(key == 1000);
+    }
+    assert(n == N);
+
+    fprintf(stdout, "%d-ary heap: OK\n", DHEAP_ARITY);
+
+    dh_destroy(heap);
+
+    return 0;
+}
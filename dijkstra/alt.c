@@ -0,0 +1,323 @@
+/**
+ * @file
+ * ALT preprocessing, landmark files and A* queries
+ */ 
+
+#include "alt.h"
+#include "util/util.h"
+
+#include <inttypes.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+/**
+ * Copies the distances of the last workspace query into column i of 
+ * a vertex-major table
+ */ 
+static void alt_store_column(const sssp_workspace_t *ws, 
+                             weight_t *table, 
+                             int k, 
+                             int i)
+{
+    vid_t v;
+
+    for ( v = 0; v < ws->nvertices; v++ )
+        table[(size_t)v*k+i] = ws->dist[v];
+}
+
+/**
+ * Selects landmarks by farthest-point selection and computes their 
+ * distance tables. The first landmark is the vertex farthest from 
+ * vertex 0; every next one is the vertex farthest from all landmarks 
+ * chosen so far, vertices that no landmark reaches coming first.
+ * @param g CSR graph
+ * @param gr transpose of g (g itself, or NULL, for undirected graphs)
+ * @param nlandmarks number of landmarks (at most g->nvertices)
+ * @return pointer to landmark tables
+ */ 
+alt_t* alt_build(csr_t *g, csr_t *gr, int nlandmarks)
+{
+    int i;
+    vid_t v, next;
+    weight_t *mind, best;
+    sssp_workspace_t *ws;
+    alt_t *alt = (alt_t*)malloc_safe(sizeof(alt_t));
+    int k = nlandmarks;
+
+    if ( gr == NULL )
+        gr = g;
+
+    alt->nvertices = g->nvertices;
+    alt->nlandmarks = k;
+    alt->mapping = NULL;
+    alt->mapping_len = 0;
+    alt->landmarks = (vid_t*)malloc_safe(k * sizeof(vid_t));
+    alt->from = (weight_t*)malloc_safe((size_t)g->nvertices * k * 
+                                       sizeof(weight_t));
+    alt->to = gr == g ? alt->from : 
+              (weight_t*)malloc_safe((size_t)g->nvertices * k * 
+                                     sizeof(weight_t));
+
+    ws = sssp_workspace_create(g->nvertices);
+    mind = (weight_t*)malloc_safe(g->nvertices * sizeof(weight_t));
+
+    // Start from the vertex farthest from vertex 0
+    dijkstra_ws_csr(g, 0, ws);
+    for ( v = 0; v < g->nvertices; v++ )
+        mind[v] = ws->dist[v] < INFINITY ? ws->dist[v] : -INFINITY;
+
+    for ( i = 0; i < k; i++ ) {
+        // Farthest vertex; mind[v] is +INFINITY for vertices reached 
+        // by no landmark
+        next = 0;
+        best = -INFINITY;
+        for ( v = 0; v < g->nvertices; v++ ) {
+            if ( mind[v] > best ) {
+                best = mind[v];
+                next = v;
+            }
+        }
+        if ( i == 0 ) {
+            for ( v = 0; v < g->nvertices; v++ )
+                mind[v] = INFINITY;
+        }
+        alt->landmarks[i] = next;
+
+        dijkstra_ws_csr(g, next, ws);
+        alt_store_column(ws, alt->from, k, i);
+        for ( v = 0; v < g->nvertices; v++ )
+            if ( ws->dist[v] < mind[v] )
+                mind[v] = ws->dist[v];
+        if ( gr != g ) {
+            dijkstra_ws_csr(gr, next, ws);
+            alt_store_column(ws, alt->to, k, i);
+        }
+        
+        // Landmarks are never picked twice
+        mind[next] = -INFINITY;
+    }
+
+    free(mind);
+    sssp_workspace_destroy(ws);
+
+    return alt;
+}
+
+/**
+ * Deallocates landmark tables
+ * @param alt pointer to landmark tables
+ */ 
+void alt_destroy(alt_t *alt)
+{
+    if ( alt->mapping ) {
+        munmap(alt->mapping, alt->mapping_len);
+    } else {
+        if ( alt->to != alt->from )
+            free(alt->to);
+        free(alt->from);
+        free(alt->landmarks);
+    }
+    free(alt);
+}
+
+/**
+ * Writes landmark tables to a binary file
+ * @param alt pointer to landmark tables
+ * @param filename output file name
+ */ 
+void alt_write(alt_t *alt, const char *filename)
+{
+    FILE *fp;
+    alt_file_header_t h;
+    uint64_t table_bytes;
+
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, ALT_FILE_MAGIC, sizeof(h.magic));
+    h.version = ALT_FILE_VERSION;
+    h.weight_bytes = sizeof(weight_t);
+    h.id_bytes = sizeof(vid_t);
+    h.nlandmarks = alt->nlandmarks;
+    h.is_symmetric = alt->to == alt->from;
+    h.nvertices = alt->nvertices;
+    table_bytes = h.nvertices * h.nlandmarks * sizeof(weight_t);
+    h.landmarks_pos = binfile_align(sizeof(h));
+    h.from_pos = binfile_align(h.landmarks_pos + 
+                               h.nlandmarks * sizeof(vid_t));
+    h.to_pos = h.is_symmetric ? h.from_pos 
+                              : binfile_align(h.from_pos + table_bytes);
+    h.file_size = h.to_pos + table_bytes;
+
+    if ( !(fp = fopen(filename, "wb")) ) {
+        perror("Error while opening file for writing: ");
+        exit(EXIT_FAILURE);
+    }
+
+    binfile_put(fp, 0, &h, sizeof(h));
+    binfile_put(fp, h.landmarks_pos, alt->landmarks, 
+                h.nlandmarks * sizeof(vid_t));
+    binfile_put(fp, h.from_pos, alt->from, table_bytes);
+    if ( !h.is_symmetric )
+        binfile_put(fp, h.to_pos, alt->to, table_bytes);
+
+    if ( fclose(fp) != 0 ) {
+        perror("Error while writing landmark file: ");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * Checks whether a file is a landmark file
+ * @param filename file name
+ * @return 1 if the file starts with the landmark file magic, 0 otherwise
+ */
+int alt_is_file(const char *filename)
+{
+    return binfile_has_magic(filename, ALT_FILE_MAGIC);
+}
+
+/**
+ * Loads landmark tables by mapping a landmark file in memory. Nothing 
+ * is copied; alt_destroy() releases the mapping. The file must have 
+ * been built for a graph with the given number of vertices.
+ * @param filename landmark file name
+ * @param nvertices number of vertices of the graph queried
+ * @return pointer to read-only landmark tables
+ */ 
+alt_t* alt_mmap(const char *filename, vid_t nvertices)
+{
+    size_t len;
+    char *base;
+    alt_file_header_t *h;
+    alt_t *alt;
+
+    base = binfile_map(filename, ALT_FILE_MAGIC, ALT_FILE_VERSION,
+                       sizeof(alt_file_header_t),
+                       offsetof(alt_file_header_t, file_size), &len);
+    h = (alt_file_header_t*)base;
+    if ( h->weight_bytes != sizeof(weight_t) || 
+         h->id_bytes != sizeof(vid_t) ) {
+        fprintf(stderr, "%s: Landmark file type widths do not match "
+                        "this build\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+    if ( h->nvertices != nvertices ) {
+        fprintf(stderr, "%s: %s was built for a graph with %" PRIu64 
+                " vertices, not %" PRIvid "\n", 
+                __FUNCTION__, filename, h->nvertices, nvertices);
+        exit(EXIT_FAILURE);
+    }
+    if ( h->nlandmarks > INT_MAX || 
+         (h->nlandmarks > 0 && h->nvertices > UINT64_MAX / h->nlandmarks) ) {
+        fprintf(stderr, "%s: %s has too many landmarks\n", 
+                __FUNCTION__, filename);
+        exit(EXIT_FAILURE);
+    }
+    binfile_check_array(filename, len, h->landmarks_pos, h->nlandmarks, 
+                        sizeof(vid_t));
+    binfile_check_array(filename, len, h->from_pos, 
+                        h->nvertices * h->nlandmarks, sizeof(weight_t));
+    binfile_check_array(filename, len, h->to_pos, 
+                        h->nvertices * h->nlandmarks, sizeof(weight_t));
+
+    alt = (alt_t*)malloc_safe(sizeof(alt_t));
+    alt->nvertices = h->nvertices;
+    alt->nlandmarks = h->nlandmarks;
+    alt->landmarks = (vid_t*)(base + h->landmarks_pos);
+    alt->from = (weight_t*)(base + h->from_pos);
+    alt->to = (weight_t*)(base + h->to_pos);
+    alt->mapping = base;
+    alt->mapping_len = len;
+
+    return alt;
+}
+
+/**
+ * Lower bound on d(v,t) from the landmark tables; landmarks that do 
+ * not reach both vertices (or are not reached from both) are ignored
+ * @param alt pointer to landmark tables
+ * @param v vertex id
+ * @param ft d(L,t) for every landmark L
+ * @param tt d(t,L) for every landmark L
+ * @return lower bound
+ */ 
+static inline weight_t alt_bound(const alt_t *alt, 
+                                 vid_t v, 
+                                 const weight_t *ft, 
+                                 const weight_t *tt)
+{
+    int i, k = alt->nlandmarks;
+    const weight_t *fv = alt->from + (size_t)v*k;
+    const weight_t *tv = alt->to + (size_t)v*k;
+    weight_t h = 0, b;
+
+    for ( i = 0; i < k; i++ ) {
+        if ( ft[i] < INFINITY && fv[i] < INFINITY ) {
+            b = ft[i] - fv[i];
+            if ( b > h )
+                h = b;
+        }
+        if ( tv[i] < INFINITY && tt[i] < INFINITY ) {
+            b = tv[i] - tt[i];
+            if ( b > h )
+                h = b;
+        }
+    }
+
+    return h;
+}
+
+/**
+ * A* point-to-point query with landmark lower bounds, in a workspace. 
+ * Heap keys are distance plus lower bound; the search stops once t is 
+ * settled. The workspace holds the distances and predecessors of the 
+ * visited vertices afterwards, so sssp_path() gives the path.
+ * @param g CSR graph
+ * @param alt pointer to landmark tables of g
+ * @param s source vertex id
+ * @param t target vertex id
+ * @param ws pointer to workspace
+ * @return distance from s to t (INFINITY if t is unreachable)
+ */ 
+weight_t alt_query_csr(csr_t *g, 
+                       const alt_t *alt, 
+                       vid_t s, 
+                       vid_t t, 
+                       sssp_workspace_t *ws)
+{
+    vid_t u, v;
+    eid_t e, end;
+    int k = alt->nlandmarks;
+    weight_t fkey, sum, ft[k], tt[k];
+    lheap_t *heap = ws->heap;
+
+    memcpy(ft, alt->from + (size_t)t*k, k * sizeof(weight_t));
+    memcpy(tt, alt->to + (size_t)t*k, k * sizeof(weight_t));
+
+    sssp_workspace_reset(ws);
+    sssp_touch(ws, s, 0, s);
+    lh_push(heap, s, alt_bound(alt, s, ft, tt));
+
+    while ( !lh_empty(heap) ) {
+        u = lh_pop(heap, &fkey);
+        if ( fkey > ws->dist[u] + alt_bound(alt, u, ft, tt) )
+            continue;
+        if ( u == t )
+            break;
+
+        end = g->offsets[u+1];
+        for ( e = g->offsets[u]; e < end; e++ ) {
+            v = g->neighbors[e];
+            sum = ws->dist[u] + g->weights[e];
+            if ( ws->dist[v] > sum ) {
+                sssp_touch(ws, v, sum, u);
+                lh_push(heap, v, sum + alt_bound(alt, v, ft, tt));
+            }
+        }
+    }
+
+    return ws->dist[t];
+}
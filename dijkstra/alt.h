@@ -0,0 +1,77 @@
+/**
+ * @file
+ * ALT (A*, landmarks, triangle inequality) type definitions and 
+ * function declarations.
+ *
+ * Preprocessing picks k landmarks by farthest-point selection and 
+ * stores, for every vertex v and landmark L, d(L,v) and d(v,L). For a 
+ * query towards t, max over L of d(L,t)-d(L,v) and d(v,L)-d(t,L) is a 
+ * lower bound on d(v,t), which guides an A* search. Tables are stored 
+ * vertex-major, so the k distances of a vertex are contiguous.
+ *
+ * Tables can be saved to a binary file and mapped back in memory:
+ *   header (alt_file_header_t), zero-padded to ALT_FILE_ALIGN
+ *   landmark ids (nlandmarks entries), zero-padded to ALT_FILE_ALIGN
+ *   from table (nvertices*nlandmarks entries), zero-padded
+ *   to table (same size; absent for undirected graphs)
+ */ 
+
+#ifndef ALT_H_
+#define ALT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sssp_workspace.h"
+#include "graph/binfile.h"
+#include "graph/csr.h"
+#include "graph/graph.h"
+
+#define ALT_FILE_MAGIC "GRAPHALT"
+#define ALT_FILE_VERSION 1
+#define ALT_FILE_ALIGN BINFILE_ALIGN
+
+/**
+ * Landmark distance tables
+ */ 
+typedef struct alt_st {
+    vid_t nvertices; //!< number of graph vertices
+    int nlandmarks; //!< number of landmarks
+    vid_t *landmarks; //!< landmark ids
+    weight_t *from; //!< from[v*nlandmarks+i] = d(landmarks[i],v)
+    weight_t *to; //!< to[v*nlandmarks+i] = d(v,landmarks[i]) (same 
+                  //!< array as from for undirected graphs)
+    void *mapping; //!< file mapping backing the tables (NULL if malloc'd)
+    size_t mapping_len; //!< length of the file mapping
+} alt_t;
+
+/**
+ * Landmark file header
+ */ 
+typedef struct alt_file_header_st {
+    char magic[8]; //!< ALT_FILE_MAGIC, not NUL-terminated
+    uint32_t version; //!< ALT_FILE_VERSION
+    uint32_t weight_bytes; //!< size of a distance
+    uint32_t id_bytes; //!< size of a vertex id
+    uint32_t nlandmarks; //!< number of landmarks
+    uint32_t is_symmetric; //!< 1 if the to table is the from table
+    uint32_t reserved; //!< zero
+    uint64_t nvertices; //!< number of vertices
+    uint64_t landmarks_pos; //!< file position of the landmark ids
+    uint64_t from_pos; //!< file position of the from table
+    uint64_t to_pos; //!< file position of the to table
+    uint64_t file_size; //!< total file size
+} alt_file_header_t;
+
+extern alt_t* alt_build(csr_t *g, csr_t *gr, int nlandmarks);
+extern void alt_destroy(alt_t *alt);
+extern void alt_write(alt_t *alt, const char *filename);
+extern alt_t* alt_mmap(const char *filename, vid_t nvertices);
+extern int alt_is_file(const char *filename);
+extern weight_t alt_query_csr(csr_t *g, 
+                              const alt_t *alt, 
+                              vid_t s, 
+                              vid_t t, 
+                              sssp_workspace_t *ws);
+
+#endif
@@ -0,0 +1,959 @@
+/**
+ * @file
+ * Contraction Hierarchies preprocessing, hierarchy files and queries
+ */
+
+#include "ch.h"
+#include "graph/parallel.h"
+#include "util/util.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+/**
+ * Vertex states during preprocessing
+ */
+enum { CH_ACTIVE = 0, CH_SELECTED, CH_CONTRACTED };
+
+/**
+ * Edge of the preprocessing graph
+ */
+typedef struct ch_arc_st {
+    vid_t id; //!< other endpoint
+    weight_t weight; //!< edge weight
+    vid_t mid; //!< bypassed vertex (VID_MAX for original edges)
+} ch_arc_t;
+
+/**
+ * Growable edge array of a vertex
+ */
+typedef struct ch_row_st {
+    ch_arc_t *arcs; //!< edges
+    eid_t deg; //!< number of edges
+    eid_t cap; //!< allocated entries
+} ch_row_t;
+
+/**
+ * Shortcut found by a contraction
+ */
+typedef struct ch_shortcut_st {
+    vid_t src; //!< tail
+    vid_t dst; //!< head
+    vid_t mid; //!< contracted vertex
+    weight_t weight; //!< length of the path through mid
+} ch_shortcut_t;
+
+/**
+ * Preprocessing state. Once a vertex is contracted, its rows only hold
+ * its hierarchy edges, towards vertices contracted after it.
+ */
+typedef struct ch_build_st {
+    vid_t nvertices; //!< number of vertices
+    ch_row_t *out; //!< outgoing edges of every vertex
+    ch_row_t *in; //!< incoming edges of every vertex (ids are tails)
+    unsigned char *state; //!< one of CH_* per vertex
+    unsigned char *dirty; //!< priority must be recomputed
+    int *priority; //!< contraction priority (lower first)
+    vid_t *ncontracted; //!< contracted neighbors of every vertex
+    vid_t *active; //!< vertices not contracted yet
+    vid_t nactive; //!< number of active vertices
+    vid_t *selected; //!< vertices contracted in the current round
+    vid_t nselected; //!< number of selected vertices
+    vid_t *list; //!< input of the priority and selection phases
+    vid_t nlist; //!< number of vertices in list
+    int nthreads; //!< number of threads
+} ch_build_t;
+
+/**
+ * Per-thread state of ch_build()
+ */
+typedef struct ch_targs_st {
+    ch_build_t *b; //!< preprocessing state
+    int id; //!< thread index
+    sssp_workspace_t *ws; //!< witness search workspace
+    eid_t *mark; //!< mark[w] == stamp for the targets of a search
+    eid_t stamp; //!< current witness search stamp
+    ch_shortcut_t *shortcuts; //!< shortcuts of the current round
+    eid_t nshortcuts; //!< number of shortcuts
+    eid_t capacity; //!< allocated shortcuts
+    vid_t nselected; //!< vertices selected from the own active range
+} ch_targs_t;
+
+/**
+ * Appends an edge to a row
+ */
+static void ch_row_append(ch_row_t *row, vid_t id, weight_t weight, vid_t mid)
+{
+    if ( row->deg == row->cap ) {
+        row->cap = row->cap ? 2 * row->cap : 4;
+        row->arcs = (ch_arc_t*)realloc(row->arcs, row->cap * sizeof(ch_arc_t));
+        if ( !row->arcs ) {
+            fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+            exit(EXIT_FAILURE);
+        }
+    }
+    row->arcs[row->deg].id = id;
+    row->arcs[row->deg].weight = weight;
+    row->arcs[row->deg].mid = mid;
+    row->deg++;
+}
+
+/**
+ * Sets the weight and middle vertex of the edge to id in a row
+ */
+static void ch_row_update(ch_row_t *row, vid_t id, weight_t weight, vid_t mid)
+{
+    eid_t i;
+
+    for ( i = 0; row->arcs[i].id != id; i++ )
+        ;
+    row->arcs[i].weight = weight;
+    row->arcs[i].mid = mid;
+}
+
+/**
+ * Removes the edge to id from a row (order is not kept)
+ */
+static void ch_row_remove(ch_row_t *row, vid_t id)
+{
+    eid_t i;
+
+    for ( i = 0; row->arcs[i].id != id; i++ )
+        ;
+    row->arcs[i] = row->arcs[--row->deg];
+}
+
+/**
+ * Adds a shortcut, or lowers the weight of an existing edge between the
+ * same vertices
+ */
+static void ch_add_shortcut(ch_build_t *b, const ch_shortcut_t *sc)
+{
+    ch_row_t *row = &b->out[sc->src];
+    eid_t i;
+
+    for ( i = 0; i < row->deg; i++ ) {
+        if ( row->arcs[i].id == sc->dst ) {
+            if ( sc->weight < row->arcs[i].weight ) {
+                row->arcs[i].weight = sc->weight;
+                row->arcs[i].mid = sc->mid;
+                ch_row_update(&b->in[sc->dst], sc->src, sc->weight, sc->mid);
+            }
+            return;
+        }
+    }
+    ch_row_append(row, sc->dst, sc->weight, sc->mid);
+    ch_row_append(&b->in[sc->dst], sc->src, sc->weight, sc->mid);
+}
+
+/**
+ * Appends a shortcut to the buffer of a thread
+ */
+static void ch_shortcut_append(ch_targs_t *ta,
+                               vid_t src,
+                               vid_t dst,
+                               vid_t mid,
+                               weight_t weight)
+{
+    if ( ta->nshortcuts == ta->capacity ) {
+        ta->capacity = ta->capacity ? 2 * ta->capacity : 64;
+        ta->shortcuts = (ch_shortcut_t*)realloc(ta->shortcuts,
+                                                ta->capacity *
+                                                sizeof(ch_shortcut_t));
+        if ( !ta->shortcuts ) {
+            fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+            exit(EXIT_FAILURE);
+        }
+    }
+    ta->shortcuts[ta->nshortcuts].src = src;
+    ta->shortcuts[ta->nshortcuts].dst = dst;
+    ta->shortcuts[ta->nshortcuts].mid = mid;
+    ta->shortcuts[ta->nshortcuts].weight = weight;
+    ta->nshortcuts++;
+}
+
+/**
+ * Witness search: Dijkstra from u over the active vertices other than
+ * v, until the ntargets marked vertices are settled, or up to distance
+ * limit or CH_WITNESS_SETTLED settled vertices
+ */
+static void ch_witness(ch_build_t *b,
+                       ch_targs_t *ta,
+                       vid_t u,
+                       vid_t v,
+                       weight_t limit,
+                       eid_t ntargets)
+{
+    sssp_workspace_t *ws = ta->ws;
+    vid_t x, y;
+    eid_t i;
+    int nsettled = 0;
+    weight_t key, sum;
+    ch_row_t *row;
+
+    sssp_workspace_reset(ws);
+    sssp_touch(ws, u, 0, u);
+    lh_push(ws->heap, u, 0);
+
+    while ( !lh_empty(ws->heap) && nsettled < CH_WITNESS_SETTLED ) {
+        x = lh_pop(ws->heap, &key);
+        if ( key > ws->dist[x] )
+            continue;
+        if ( key > limit )
+            break;
+        if ( ta->mark[x] == ta->stamp && --ntargets == 0 )
+            break;
+        nsettled++;
+
+        row = &b->out[x];
+        for ( i = 0; i < row->deg; i++ ) {
+            y = row->arcs[i].id;
+            if ( y == v || b->state[y] != CH_ACTIVE )
+                continue;
+            sum = key + row->arcs[i].weight;
+            if ( ws->dist[y] > sum ) {
+                sssp_touch(ws, y, sum, x);
+                lh_push(ws->heap, y, sum);
+            }
+        }
+    }
+}
+
+/**
+ * Finds the shortcuts needed to contract a vertex: one for every pair
+ * of active neighbors u->v->w without a witness
+ * @param b preprocessing state
+ * @param ta thread state (witness search space, shortcut buffer)
+ * @param v vertex id
+ * @param store 1 to append the shortcuts to the thread buffer, 0 to
+ *        only count them
+ * @return number of shortcuts
+ */
+static int ch_contract(ch_build_t *b, ch_targs_t *ta, vid_t v, int store)
+{
+    ch_row_t *in = &b->in[v], *out = &b->out[v];
+    eid_t i, j, ntargets;
+    vid_t u, w;
+    weight_t d, limit;
+    int nshortcuts = 0;
+
+    for ( i = 0; i < in->deg; i++ ) {
+        u = in->arcs[i].id;
+        if ( b->state[u] != CH_ACTIVE )
+            continue;
+
+        limit = -1;
+        ntargets = 0;
+        ta->stamp++;
+        for ( j = 0; j < out->deg; j++ ) {
+            w = out->arcs[j].id;
+            if ( w == u || b->state[w] != CH_ACTIVE )
+                continue;
+            d = in->arcs[i].weight + out->arcs[j].weight;
+            if ( d > limit )
+                limit = d;
+            ta->mark[w] = ta->stamp;
+            ntargets++;
+        }
+        if ( ntargets == 0 )
+            continue;
+
+        ch_witness(b, ta, u, v, limit, ntargets);
+        for ( j = 0; j < out->deg; j++ ) {
+            w = out->arcs[j].id;
+            if ( w == u || b->state[w] != CH_ACTIVE )
+                continue;
+            d = in->arcs[i].weight + out->arcs[j].weight;
+            if ( ta->ws->dist[w] > d ) {
+                nshortcuts++;
+                if ( store )
+                    ch_shortcut_append(ta, u, w, v, d);
+            }
+        }
+    }
+
+    return nshortcuts;
+}
+
+/**
+ * Contraction priority of a vertex: edge difference plus contracted
+ * neighbors
+ */
+static int ch_priority(ch_build_t *b, ch_targs_t *ta, vid_t v)
+{
+    int p = ch_contract(b, ta, v, 0) + (int)b->ncontracted[v];
+    eid_t i;
+
+    for ( i = 0; i < b->in[v].deg; i++ )
+        p -= b->state[b->in[v].arcs[i].id] == CH_ACTIVE;
+    for ( i = 0; i < b->out[v].deg; i++ )
+        p -= b->state[b->out[v].arcs[i].id] == CH_ACTIVE;
+
+    return p;
+}
+
+/**
+ * Scrambles vertex ids, to break priority ties without favoring areas
+ * of the id space
+ */
+static inline uint32_t ch_hash(vid_t v)
+{
+    return (uint32_t)v * 2654435761u;
+}
+
+/**
+ * Returns whether v comes before x in the contraction order
+ */
+static inline int ch_before(const ch_build_t *b, vid_t v, vid_t x)
+{
+    if ( b->priority[v] != b->priority[x] )
+        return b->priority[v] < b->priority[x];
+    if ( ch_hash(v) != ch_hash(x) )
+        return ch_hash(v) < ch_hash(x);
+    return v < x;
+}
+
+/**
+ * Returns whether v comes before all its active neighbors in a row
+ */
+static int ch_is_local_min(const ch_build_t *b, const ch_row_t *row, vid_t v)
+{
+    eid_t i;
+    vid_t x;
+
+    for ( i = 0; i < row->deg; i++ ) {
+        x = row->arcs[i].id;
+        if ( b->state[x] == CH_ACTIVE && !ch_before(b, v, x) )
+            return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * Part of a vertex list handled by a thread
+ */
+static inline void ch_thread_range(const ch_targs_t *ta,
+                                   vid_t n,
+                                   vid_t *begin,
+                                   vid_t *end)
+{
+    *begin = (vid_t)((uint64_t)n * ta->id / ta->b->nthreads);
+    *end = (vid_t)((uint64_t)n * (ta->id + 1) / ta->b->nthreads);
+}
+
+/**
+ * Thread function recomputing the priorities of the dirty vertices of
+ * the list
+ */
+static void* ch_priority_thread(void *arg)
+{
+    ch_targs_t *ta = (ch_targs_t*)arg;
+    ch_build_t *b = ta->b;
+    vid_t i, v, begin, end;
+
+    ch_thread_range(ta, b->nlist, &begin, &end);
+    for ( i = begin; i < end; i++ ) {
+        v = b->list[i];
+        if ( b->dirty[v] ) {
+            b->priority[v] = ch_priority(b, ta, v);
+            b->dirty[v] = 0;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Thread function selecting the vertices of the list that come before
+ * all their active neighbors. They are written to the selected list at
+ * the start of the own range (the list may be the selected list).
+ */
+static void* ch_select_thread(void *arg)
+{
+    ch_targs_t *ta = (ch_targs_t*)arg;
+    ch_build_t *b = ta->b;
+    vid_t i, v, begin, end;
+
+    ch_thread_range(ta, b->nlist, &begin, &end);
+    ta->nselected = 0;
+    for ( i = begin; i < end; i++ ) {
+        v = b->list[i];
+        if ( ch_is_local_min(b, &b->out[v], v) &&
+             ch_is_local_min(b, &b->in[v], v) )
+            b->selected[begin + ta->nselected++] = v;
+    }
+
+    return NULL;
+}
+
+/**
+ * Selects the vertices of the list that come before all their active
+ * neighbors, in parallel, into the selected list
+ */
+static void ch_select(ch_build_t *b, ch_targs_t *targs)
+{
+    vid_t i, k;
+    int j;
+
+    parallel_run(ch_select_thread, targs, sizeof(ch_targs_t), b->nthreads);
+    b->nselected = 0;
+    for ( j = 0; j < b->nthreads; j++ ) {
+        k = (vid_t)((uint64_t)b->nlist * j / b->nthreads);
+        for ( i = 0; i < targs[j].nselected; i++ )
+            b->selected[b->nselected++] = b->selected[k + i];
+    }
+}
+
+/**
+ * Thread function finding the shortcuts of the selected vertices
+ */
+static void* ch_contract_thread(void *arg)
+{
+    ch_targs_t *ta = (ch_targs_t*)arg;
+    ch_build_t *b = ta->b;
+    vid_t i, begin, end;
+
+    ch_thread_range(ta, b->nselected, &begin, &end);
+    ta->nshortcuts = 0;
+    for ( i = begin; i < end; i++ )
+        ch_contract(b, ta, b->selected[i], 1);
+
+    return NULL;
+}
+
+/**
+ * Copies the edges of every vertex towards higher ranked vertices
+ */
+static void ch_collect(const ch_row_t *rows,
+                       const vid_t *rank,
+                       vid_t nvertices,
+                       ch_edges_t *edges)
+{
+    vid_t v;
+    eid_t i, k;
+    const ch_arc_t *a;
+
+    edges->offsets = (eid_t*)malloc_safe((nvertices + 1) * sizeof(eid_t));
+    edges->nedges = 0;
+    for ( v = 0; v < nvertices; v++ ) {
+        edges->offsets[v] = edges->nedges;
+        for ( i = 0; i < rows[v].deg; i++ )
+            edges->nedges += rank[rows[v].arcs[i].id] > rank[v];
+    }
+    edges->offsets[nvertices] = edges->nedges;
+
+    edges->ids = (vid_t*)malloc_safe(edges->nedges * sizeof(vid_t));
+    edges->weights = (weight_t*)malloc_safe(edges->nedges * sizeof(weight_t));
+    edges->mids = (vid_t*)malloc_safe(edges->nedges * sizeof(vid_t));
+    for ( v = 0, k = 0; v < nvertices; v++ ) {
+        for ( i = 0; i < rows[v].deg; i++ ) {
+            a = &rows[v].arcs[i];
+            if ( rank[a->id] > rank[v] ) {
+                edges->ids[k] = a->id;
+                edges->weights[k] = a->weight;
+                edges->mids[k] = a->mid;
+                k++;
+            }
+        }
+    }
+}
+
+/**
+ * Builds a contraction hierarchy
+ * @param g CSR graph (non-negative weights)
+ * @param nthreads number of threads (<=0 for all online processors)
+ * @return pointer to hierarchy
+ */
+ch_t* ch_build(csr_t *g, int nthreads)
+{
+    ch_build_t b;
+    ch_targs_t *targs;
+    ch_t *ch = (ch_t*)malloc_safe(sizeof(ch_t));
+    vid_t i, k, v, n = g->nvertices, next_rank = 0;
+    eid_t e;
+    int j;
+
+    if ( nthreads <= 0 )
+        nthreads = parallel_default_nthreads();
+
+    b.nvertices = n;
+    b.nthreads = nthreads;
+    b.out = (ch_row_t*)malloc_safe(n * sizeof(ch_row_t));
+    b.in = (ch_row_t*)malloc_safe(n * sizeof(ch_row_t));
+    b.state = (unsigned char*)malloc_safe(n);
+    b.dirty = (unsigned char*)malloc_safe(n);
+    b.priority = (int*)malloc_safe(n * sizeof(int));
+    b.ncontracted = (vid_t*)malloc_safe(n * sizeof(vid_t));
+    b.active = (vid_t*)malloc_safe(n * sizeof(vid_t));
+    b.selected = (vid_t*)malloc_safe(n * sizeof(vid_t));
+    memset(b.out, 0, n * sizeof(ch_row_t));
+    memset(b.in, 0, n * sizeof(ch_row_t));
+    for ( v = 0; v < n; v++ ) {
+        b.state[v] = CH_ACTIVE;
+        b.dirty[v] = 1;
+        b.ncontracted[v] = 0;
+        b.active[v] = v;
+        for ( e = g->offsets[v]; e < g->offsets[v+1]; e++ ) {
+            ch_row_append(&b.out[v], g->neighbors[e], g->weights[e], VID_MAX);
+            ch_row_append(&b.in[g->neighbors[e]], v, g->weights[e], VID_MAX);
+        }
+    }
+    b.nactive = n;
+
+    targs = (ch_targs_t*)malloc_safe(nthreads * sizeof(ch_targs_t));
+    for ( j = 0; j < nthreads; j++ ) {
+        targs[j].b = &b;
+        targs[j].id = j;
+        targs[j].ws = sssp_workspace_create(n);
+        targs[j].mark = (eid_t*)malloc_safe(n * sizeof(eid_t));
+        memset(targs[j].mark, 0, n * sizeof(eid_t));
+        targs[j].stamp = 0;
+        targs[j].shortcuts = NULL;
+        targs[j].nshortcuts = 0;
+        targs[j].capacity = 0;
+    }
+
+    ch->nvertices = n;
+    ch->rank = (vid_t*)malloc_safe(n * sizeof(vid_t));
+    ch->mapping = NULL;
+    ch->mapping_len = 0;
+
+    b.list = b.active;
+    b.nlist = n;
+    parallel_run(ch_priority_thread, targs, sizeof(ch_targs_t), nthreads);
+
+    while ( b.nactive > 0 ) {
+        // Lazy updates: candidates come before their neighbors with
+        // possibly outdated priorities; only the outdated candidates 
+        // are recomputed, and the ones still before their neighbors 
+        // form an independent set. A round without any is followed by
+        // one with fewer outdated priorities, and once all candidates 
+        // are up to date, the first active vertex in the order is in it.
+        b.list = b.active;
+        b.nlist = b.nactive;
+        ch_select(&b, targs);
+        b.list = b.selected;
+        b.nlist = b.nselected;
+        parallel_run(ch_priority_thread, targs, sizeof(ch_targs_t), nthreads);
+        ch_select(&b, targs);
+        for ( i = 0; i < b.nselected; i++ )
+            b.state[b.selected[i]] = CH_SELECTED;
+
+        parallel_run(ch_contract_thread, targs, sizeof(ch_targs_t), nthreads);
+
+        for ( i = 0; i < b.nselected; i++ ) {
+            v = b.selected[i];
+            ch->rank[v] = next_rank++;
+            b.state[v] = CH_CONTRACTED;
+        }
+        for ( j = 0; j < nthreads; j++ )
+            for ( e = 0; e < targs[j].nshortcuts; e++ )
+                ch_add_shortcut(&b, &targs[j].shortcuts[e]);
+
+        // The edges of a contracted vertex are final: they leave the
+        // rows of its neighbors, which are all active and get a new
+        // priority (lazy updates: the other priorities are kept)
+        for ( i = 0; i < b.nselected; i++ ) {
+            v = b.selected[i];
+            for ( e = 0; e < b.out[v].deg; e++ ) {
+                k = b.out[v].arcs[e].id;
+                ch_row_remove(&b.in[k], v);
+                b.ncontracted[k]++;
+                b.dirty[k] = 1;
+            }
+            for ( e = 0; e < b.in[v].deg; e++ ) {
+                k = b.in[v].arcs[e].id;
+                ch_row_remove(&b.out[k], v);
+                b.ncontracted[k]++;
+                b.dirty[k] = 1;
+            }
+        }
+
+        for ( i = 0, k = 0; i < b.nactive; i++ )
+            if ( b.state[b.active[i]] == CH_ACTIVE )
+                b.active[k++] = b.active[i];
+        b.nactive = k;
+    }
+
+    ch_collect(b.out, ch->rank, n, &ch->up);
+    ch_collect(b.in, ch->rank, n, &ch->down);
+
+    for ( j = 0; j < nthreads; j++ ) {
+        sssp_workspace_destroy(targs[j].ws);
+        free(targs[j].mark);
+        free(targs[j].shortcuts);
+    }
+    free(targs);
+    for ( v = 0; v < n; v++ ) {
+        free(b.out[v].arcs);
+        free(b.in[v].arcs);
+    }
+    free(b.out);
+    free(b.in);
+    free(b.state);
+    free(b.dirty);
+    free(b.priority);
+    free(b.ncontracted);
+    free(b.active);
+    free(b.selected);
+
+    return ch;
+}
+
+/**
+ * Deallocates a hierarchy
+ * @param ch pointer to hierarchy
+ */
+void ch_destroy(ch_t *ch)
+{
+    if ( ch->mapping ) {
+        munmap(ch->mapping, ch->mapping_len);
+    } else {
+        free(ch->rank);
+        free(ch->up.offsets);
+        free(ch->up.ids);
+        free(ch->up.weights);
+        free(ch->up.mids);
+        free(ch->down.offsets);
+        free(ch->down.ids);
+        free(ch->down.weights);
+        free(ch->down.mids);
+    }
+    free(ch);
+}
+
+/**
+ * Sizes of the four arrays of an edge set, in file order
+ */
+static void ch_edges_bytes(uint64_t nvertices, uint64_t nedges,
+                           uint64_t *bytes)
+{
+    bytes[0] = (nvertices + 1) * sizeof(eid_t);
+    bytes[1] = nedges * sizeof(vid_t);
+    bytes[2] = nedges * sizeof(weight_t);
+    bytes[3] = nedges * sizeof(vid_t);
+}
+
+/**
+ * Writes a hierarchy to a binary file
+ * @param ch pointer to hierarchy
+ * @param filename output file name
+ */
+void ch_write(ch_t *ch, const char *filename)
+{
+    FILE *fp;
+    ch_file_header_t h;
+    uint64_t pos, up_bytes[4], down_bytes[4];
+    const void *up[4] = { ch->up.offsets, ch->up.ids,
+                          ch->up.weights, ch->up.mids };
+    const void *down[4] = { ch->down.offsets, ch->down.ids,
+                            ch->down.weights, ch->down.mids };
+    int i;
+
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, CH_FILE_MAGIC, sizeof(h.magic));
+    h.version = CH_FILE_VERSION;
+    h.weight_bytes = sizeof(weight_t);
+    h.id_bytes = sizeof(vid_t);
+    h.nvertices = ch->nvertices;
+    h.nup = ch->up.nedges;
+    h.ndown = ch->down.nedges;
+    ch_edges_bytes(h.nvertices, h.nup, up_bytes);
+    ch_edges_bytes(h.nvertices, h.ndown, down_bytes);
+
+    h.rank_pos = binfile_align(sizeof(h));
+    pos = h.rank_pos + h.nvertices * sizeof(vid_t);
+    for ( i = 0; i < 4; i++ ) {
+        h.up_pos[i] = binfile_align(pos);
+        pos = h.up_pos[i] + up_bytes[i];
+    }
+    for ( i = 0; i < 4; i++ ) {
+        h.down_pos[i] = binfile_align(pos);
+        pos = h.down_pos[i] + down_bytes[i];
+    }
+    h.file_size = pos;
+
+    if ( !(fp = fopen(filename, "wb")) ) {
+        perror("Error while opening file for writing: ");
+        exit(EXIT_FAILURE);
+    }
+
+    binfile_put(fp, 0, &h, sizeof(h));
+    binfile_put(fp, h.rank_pos, ch->rank, h.nvertices * sizeof(vid_t));
+    for ( i = 0; i < 4; i++ )
+        binfile_put(fp, h.up_pos[i], up[i], up_bytes[i]);
+    for ( i = 0; i < 4; i++ )
+        binfile_put(fp, h.down_pos[i], down[i], down_bytes[i]);
+
+    if ( fclose(fp) != 0 ) {
+        perror("Error while writing hierarchy file: ");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * Checks whether a file is a hierarchy file
+ * @param filename file name
+ * @return 1 if the file starts with the hierarchy file magic, 0 otherwise
+ */
+int ch_is_file(const char *filename)
+{
+    return binfile_has_magic(filename, CH_FILE_MAGIC);
+}
+
+/**
+ * Points an edge set to its arrays in a mapped file, after checking
+ * that they lie within the file, that the offsets rise from 0 to 
+ * nedges, and that endpoint and middle vertex ids are vertices
+ */
+static void ch_edges_map(ch_edges_t *edges,
+                         const char *filename,
+                         char *base,
+                         size_t len,
+                         uint64_t nvertices,
+                         uint64_t nedges,
+                         const uint64_t *pos)
+{
+    uint64_t v, e;
+
+    binfile_check_array(filename, len, pos[0], nvertices + 1, sizeof(eid_t));
+    binfile_check_array(filename, len, pos[1], nedges, sizeof(vid_t));
+    binfile_check_array(filename, len, pos[2], nedges, sizeof(weight_t));
+    binfile_check_array(filename, len, pos[3], nedges, sizeof(vid_t));
+
+    edges->nedges = nedges;
+    edges->offsets = (eid_t*)(base + pos[0]);
+    edges->ids = (vid_t*)(base + pos[1]);
+    edges->weights = (weight_t*)(base + pos[2]);
+    edges->mids = (vid_t*)(base + pos[3]);
+
+    if ( edges->offsets[0] != 0 || edges->offsets[nvertices] != nedges ) {
+        fprintf(stderr, "%s: %s has inconsistent offsets\n",
+                __FUNCTION__, filename);
+        exit(EXIT_FAILURE);
+    }
+    for ( v = 0; v < nvertices; v++ ) {
+        if ( edges->offsets[v] > edges->offsets[v+1] ) {
+            fprintf(stderr, "%s: %s has decreasing offsets\n",
+                    __FUNCTION__, filename);
+            exit(EXIT_FAILURE);
+        }
+    }
+    for ( e = 0; e < nedges; e++ ) {
+        if ( edges->ids[e] >= nvertices ||
+             (edges->mids[e] >= nvertices && edges->mids[e] != VID_MAX) ) {
+            fprintf(stderr, "%s: %s has a vertex id out of range\n",
+                    __FUNCTION__, filename);
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+/**
+ * Loads a hierarchy by mapping a hierarchy file in memory. Nothing is
+ * copied, but offsets and vertex ids are validated, which reads every
+ * array once; ch_destroy() releases the mapping.
+ * @param filename hierarchy file name
+ * @return pointer to read-only hierarchy
+ */
+ch_t* ch_mmap(const char *filename)
+{
+    size_t len;
+    char *base;
+    ch_file_header_t *h;
+    ch_t *ch;
+    vid_t v;
+
+    base = binfile_map(filename, CH_FILE_MAGIC, CH_FILE_VERSION,
+                       sizeof(ch_file_header_t),
+                       offsetof(ch_file_header_t, file_size), &len);
+    h = (ch_file_header_t*)base;
+    if ( h->weight_bytes != sizeof(weight_t) ||
+         h->id_bytes != sizeof(vid_t) ) {
+        fprintf(stderr, "%s: Hierarchy file type widths do not match "
+                        "this build\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+    // nvertices+1 offsets are checked, so that count must not wrap
+    if ( h->nvertices > VID_MAX || h->nvertices == UINT64_MAX ) {
+        fprintf(stderr, "%s: %s has too many vertices for this build\n",
+                __FUNCTION__, filename);
+        exit(EXIT_FAILURE);
+    }
+    binfile_check_array(filename, len, h->rank_pos, h->nvertices,
+                        sizeof(vid_t));
+
+    ch = (ch_t*)malloc_safe(sizeof(ch_t));
+    ch->nvertices = h->nvertices;
+    ch->rank = (vid_t*)(base + h->rank_pos);
+    for ( v = 0; v < ch->nvertices; v++ ) {
+        if ( ch->rank[v] >= ch->nvertices ) {
+            fprintf(stderr, "%s: %s has a rank out of range\n",
+                    __FUNCTION__, filename);
+            exit(EXIT_FAILURE);
+        }
+    }
+    ch_edges_map(&ch->up, filename, base, len, h->nvertices, h->nup,
+                 h->up_pos);
+    ch_edges_map(&ch->down, filename, base, len, h->nvertices, h->ndown,
+                 h->down_pos);
+    ch->mapping = base;
+    ch->mapping_len = len;
+
+    return ch;
+}
+
+/**
+ * Settles one vertex of one direction of a query, and updates the best
+ * path through every vertex whose label drops. A direction whose
+ * smallest key reaches the best path length is done.
+ * @param edges edges searched in this direction
+ * @param ws workspace of this direction
+ * @param other workspace of the opposite direction
+ * @param mu length of the best path found so far
+ * @param meet vertex where the best path joins both searches
+ */
+static void ch_step(const ch_edges_t *edges,
+                    sssp_workspace_t *ws,
+                    const sssp_workspace_t *other,
+                    weight_t *mu,
+                    vid_t *meet)
+{
+    vid_t u, v;
+    eid_t e, end;
+    weight_t ukey, sum;
+
+    u = lh_pop(ws->heap, &ukey);
+    if ( ukey > ws->dist[u] )
+        return;
+    if ( ukey >= *mu ) {
+        lh_clear(ws->heap);
+        return;
+    }
+
+    end = edges->offsets[u+1];
+    for ( e = edges->offsets[u]; e < end; e++ ) {
+        v = edges->ids[e];
+        sum = ukey + edges->weights[e];
+        if ( ws->dist[v] > sum ) {
+            sssp_touch(ws, v, sum, u);
+            lh_push(ws->heap, v, sum);
+            if ( other->dist[v] < INFINITY && sum + other->dist[v] < *mu ) {
+                *mu = sum + other->dist[v];
+                *meet = v;
+            }
+        }
+    }
+}
+
+/**
+ * Point-to-point query: upward searches from s in fw and, backward,
+ * from t in bw, until neither can improve the best path
+ * @param ch pointer to hierarchy
+ * @param s source vertex id
+ * @param t target vertex id
+ * @param fw forward workspace
+ * @param bw backward workspace
+ * @param meet set to the vertex where the shortest path joins both
+ *        searches, for ch_path()
+ * @return distance from s to t (INFINITY if t is unreachable)
+ */
+weight_t ch_query(const ch_t *ch,
+                  vid_t s,
+                  vid_t t,
+                  sssp_workspace_t *fw,
+                  sssp_workspace_t *bw,
+                  vid_t *meet)
+{
+    weight_t mu = INFINITY;
+
+    sssp_workspace_reset(fw);
+    sssp_workspace_reset(bw);
+    sssp_touch(fw, s, 0, s);
+    lh_push(fw->heap, s, 0);
+    sssp_touch(bw, t, 0, t);
+    lh_push(bw->heap, t, 0);
+    *meet = s;
+    if ( s == t )
+        return 0;
+
+    while ( !lh_empty(fw->heap) || !lh_empty(bw->heap) ) {
+        if ( lh_empty(bw->heap) || (!lh_empty(fw->heap) &&
+             fw->heap->curr_size <= bw->heap->curr_size) )
+            ch_step(&ch->up, fw, bw, &mu, meet);
+        else
+            ch_step(&ch->down, bw, fw, &mu, meet);
+    }
+
+    return mu;
+}
+
+/**
+ * Appends the original vertices of the edge u->w, except u, to a path
+ */
+static vid_t ch_unpack(const ch_t *ch, vid_t u, vid_t w, vid_t *path, vid_t n)
+{
+    const ch_edges_t *edges;
+    vid_t v, other;
+    eid_t e, end;
+
+    // The edge is stored at its lower ranked endpoint
+    if ( ch->rank[u] < ch->rank[w] ) {
+        edges = &ch->up;
+        v = u;
+        other = w;
+    } else {
+        edges = &ch->down;
+        v = w;
+        other = u;
+    }
+    end = edges->offsets[v+1];
+    for ( e = edges->offsets[v]; e < end && edges->ids[e] != other; e++ )
+        ;
+    assert(e < end);
+
+    if ( edges->mids[e] == VID_MAX ) {
+        path[n++] = w;
+        return n;
+    }
+    n = ch_unpack(ch, u, edges->mids[e], path, n);
+    return ch_unpack(ch, edges->mids[e], w, path, n);
+}
+
+/**
+ * Unpacks the shortest path of the last query into original edges
+ * @param ch pointer to hierarchy
+ * @param fw forward workspace of the query
+ * @param bw backward workspace of the query
+ * @param meet meeting vertex returned by ch_query()
+ * @param path array of at least nvertices entries receiving the
+ *        vertices from s to t
+ * @return number of vertices on the path (0 if t was not reached)
+ */
+vid_t ch_path(const ch_t *ch,
+              const sssp_workspace_t *fw,
+              const sssp_workspace_t *bw,
+              vid_t meet,
+              vid_t *path)
+{
+    vid_t i, n, k, *hpath;
+
+    hpath = (vid_t*)malloc_safe(ch->nvertices * sizeof(vid_t));
+    k = sssp_bidir_path(fw, bw, meet, hpath);
+    if ( k == 0 ) {
+        free(hpath);
+        return 0;
+    }
+
+    path[0] = hpath[0];
+    for ( i = 0, n = 1; i + 1 < k; i++ )
+        n = ch_unpack(ch, hpath[i], hpath[i+1], path, n);
+    free(hpath);
+
+    return n;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file
+ * Contraction Hierarchies type definitions and function declarations.
+ *
+ * Preprocessing contracts the vertices one by one in increasing
+ * importance: removing a vertex v adds a shortcut u->w for each pair of
+ * remaining neighbors u->v->w unless a bounded witness search from u,
+ * avoiding v, finds a path that is no longer. The importance of a
+ * vertex is its edge difference (shortcuts added minus edges removed)
+ * plus the number of its neighbors already contracted; it is only
+ * recomputed for the neighbors of the vertices contracted last. Every
+ * round contracts in parallel the vertices that are more important
+ * than none of their remaining neighbors, an independent set.
+ *
+ * A query runs two Dijkstra searches that only go up in the order:
+ * forward from the source on the upward edges, and backward from the
+ * target on the downward edges, stored reversed at their head. The
+ * shortest path goes through the most important vertex on it, where
+ * both searches meet. Every shortcut records the vertex it bypasses,
+ * so paths unpack to original edges.
+ *
+ * A hierarchy can be saved to a binary file and mapped back in memory:
+ *   header (ch_file_header_t), zero-padded to CH_FILE_ALIGN
+ *   rank (nvertices entries), zero-padded to CH_FILE_ALIGN
+ *   upward edges (offsets, heads, weights, middle vertices), each
+ *   zero-padded to CH_FILE_ALIGN
+ *   downward edges (offsets, tails, weights, middle vertices), same
+ */
+
+#ifndef CH_H_
+#define CH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sssp_workspace.h"
+#include "graph/binfile.h"
+#include "graph/csr.h"
+#include "graph/graph.h"
+
+#define CH_FILE_MAGIC "GRAPH_CH"
+#define CH_FILE_VERSION 1
+#define CH_FILE_ALIGN BINFILE_ALIGN
+
+/**
+ * Maximum number of vertices settled by a witness search; a search
+ * that gives up adds the shortcuts it could not rule out
+ */
+#ifndef CH_WITNESS_SETTLED
+#define CH_WITNESS_SETTLED 500
+#endif
+
+/**
+ * Edges of one search direction, by vertex. The middle vertex of an
+ * edge is the one its shortcut bypasses (VID_MAX for original edges).
+ */
+typedef struct ch_edges_st {
+    eid_t nedges; //!< number of edges
+    eid_t *offsets; //!< per-vertex offsets, nvertices+1 entries
+    vid_t *ids; //!< other endpoints
+    weight_t *weights; //!< edge weights
+    vid_t *mids; //!< middle vertices
+} ch_edges_t;
+
+/**
+ * Contraction hierarchy
+ */
+typedef struct ch_st {
+    vid_t nvertices; //!< number of graph vertices
+    vid_t *rank; //!< contraction order of every vertex
+    ch_edges_t up; //!< edges v->w with rank[w] > rank[v], at v
+    ch_edges_t down; //!< edges u->v with rank[u] > rank[v], at v
+    void *mapping; //!< file mapping backing the arrays (NULL if malloc'd)
+    size_t mapping_len; //!< length of the file mapping
+} ch_t;
+
+/**
+ * Hierarchy file header
+ */
+typedef struct ch_file_header_st {
+    char magic[8]; //!< CH_FILE_MAGIC, not NUL-terminated
+    uint32_t version; //!< CH_FILE_VERSION
+    uint32_t weight_bytes; //!< size of a weight
+    uint32_t id_bytes; //!< size of a vertex id
+    uint32_t reserved; //!< zero
+    uint64_t nvertices; //!< number of vertices
+    uint64_t nup; //!< number of upward edges
+    uint64_t ndown; //!< number of downward edges
+    uint64_t rank_pos; //!< file position of the ranks
+    uint64_t up_pos[4]; //!< positions of the upward edge arrays
+    uint64_t down_pos[4]; //!< positions of the downward edge arrays
+    uint64_t file_size; //!< total file size
+} ch_file_header_t;
+
+extern ch_t* ch_build(csr_t *g, int nthreads);
+extern void ch_destroy(ch_t *ch);
+extern void ch_write(ch_t *ch, const char *filename);
+extern ch_t* ch_mmap(const char *filename);
+extern int ch_is_file(const char *filename);
+extern weight_t ch_query(const ch_t *ch,
+                         vid_t s,
+                         vid_t t,
+                         sssp_workspace_t *fw,
+                         sssp_workspace_t *bw,
+                         vid_t *meet);
+extern vid_t ch_path(const ch_t *ch,
+                     const sssp_workspace_t *fw,
+                     const sssp_workspace_t *bw,
+                     vid_t meet,
+                     vid_t *path);
+
+#endif
@@ -0,0 +1,461 @@
+/**
+ * @file
+ * Parallel delta-stepping single-source shortest paths
+ */
+
+#include "delta_stepping.h"
+#include "graph/parallel.h"
+#include "util/util.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Distances are lowered through their bit patterns, which order
+ * non-negative floats as their values do
+ */
+typedef char ds_weight_is_32bit_t[sizeof(weight_t) == sizeof(uint32_t) ? 1 : -1];
+
+/**
+ * Growable array of vertices
+ */
+typedef struct ds_bucket_st {
+    vid_t *vertices; //!< vertex ids
+    eid_t size; //!< number of vertices
+    eid_t capacity; //!< allocated entries
+} ds_bucket_t;
+
+struct ds_shared_st;
+
+/**
+ * Per-thread state
+ */
+typedef struct ds_thread_st {
+    int id; //!< thread index
+    struct ds_shared_st *sh; //!< shared state
+    ds_bucket_t *buckets; //!< own buckets, indexed by bucket number
+    size_t nbuckets; //!< allocated buckets
+    ds_bucket_t removed; //!< vertices taken from the current bucket
+    eid_t offset; //!< position of the own bucket in the frontier
+    vid_t vbegin; //!< first vertex of the predecessor pass
+    vid_t vend; //!< last vertex (exclusive) of the predecessor pass
+} ds_thread_t;
+
+/**
+ * State shared by all threads
+ */
+typedef struct ds_shared_st {
+    csr_t *g; //!< graph
+    weight_t delta; //!< bucket width
+    uint32_t *dist; //!< distance bit patterns
+    vid_t *pred; //!< predecessor array
+    int nthreads; //!< number of threads
+    ds_thread_t *threads; //!< per-thread states
+    pthread_barrier_t barrier; //!< phase barrier
+    vid_t *frontier; //!< gathered current bucket
+    eid_t frontier_size; //!< vertices in the frontier
+    eid_t frontier_capacity; //!< allocated frontier entries
+    size_t curr; //!< current bucket number
+    int done; //!< set once all buckets are empty
+} ds_shared_t;
+
+/**
+ * Appends a vertex to a bucket
+ */
+static inline void ds_bucket_append(ds_bucket_t *b, vid_t v)
+{
+    if ( b->size == b->capacity ) {
+        b->capacity = b->capacity ? 2 * b->capacity : 64;
+        b->vertices = (vid_t*)realloc(b->vertices,
+                                      b->capacity * sizeof(vid_t));
+        if ( !b->vertices ) {
+            fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+            exit(EXIT_FAILURE);
+        }
+    }
+    b->vertices[b->size++] = v;
+}
+
+/**
+ * Returns a bucket of a thread, allocating buckets up to it
+ */
+static ds_bucket_t* ds_thread_bucket(ds_thread_t *th, size_t b)
+{
+    size_t n;
+
+    if ( b >= th->nbuckets ) {
+        n = th->nbuckets ? 2 * th->nbuckets : 64;
+        if ( n <= b )
+            n = b + 1;
+        th->buckets = (ds_bucket_t*)realloc(th->buckets,
+                                            n * sizeof(ds_bucket_t));
+        if ( !th->buckets ) {
+            fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+            exit(EXIT_FAILURE);
+        }
+        memset(th->buckets + th->nbuckets, 0,
+               (n - th->nbuckets) * sizeof(ds_bucket_t));
+        th->nbuckets = n;
+    }
+
+    return &th->buckets[b];
+}
+
+/**
+ * Reads a distance
+ */
+static inline weight_t ds_load(const uint32_t *dist, vid_t v)
+{
+    uint32_t bits = __atomic_load_n(&dist[v], __ATOMIC_RELAXED);
+    weight_t d;
+
+    memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+/**
+ * Lowers a distance to d if it is larger
+ * @return 1 if the distance was lowered, 0 otherwise
+ */
+static inline int ds_atomic_min(uint32_t *dist, vid_t v, weight_t d)
+{
+    uint32_t bits, old = __atomic_load_n(&dist[v], __ATOMIC_RELAXED);
+
+    memcpy(&bits, &d, sizeof(bits));
+    while ( bits < old ) {
+        if ( __atomic_compare_exchange_n(&dist[v], &old, bits, 1,
+                                         __ATOMIC_RELAXED, __ATOMIC_RELAXED) )
+            return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * Returns the bucket number of a distance
+ */
+static inline size_t ds_bucket_of(const ds_shared_t *sh, weight_t d)
+{
+    return (size_t)(d / sh->delta);
+}
+
+/**
+ * Relaxes the light (or heavy) edges of a vertex, pushing the vertices
+ * whose distance drops to the thread's buckets
+ * @param th thread state
+ * @param u vertex id
+ * @param du distance of u
+ * @param light 1 for edges of weight <= delta, 0 for the others
+ */
+static void ds_relax(ds_thread_t *th, vid_t u, weight_t du, int light)
+{
+    ds_shared_t *sh = th->sh;
+    csr_t *g = sh->g;
+    eid_t e, end = g->offsets[u+1];
+    weight_t w, sum;
+    vid_t v;
+
+    for ( e = g->offsets[u]; e < end; e++ ) {
+        w = g->weights[e];
+        if ( (w <= sh->delta) != light )
+            continue;
+        v = g->neighbors[e];
+        sum = du + w;
+        if ( ds_atomic_min(sh->dist, v, sum) )
+            ds_bucket_append(ds_thread_bucket(th, ds_bucket_of(sh, sum)), v);
+    }
+}
+
+/**
+ * Moves the current bucket of every thread to the shared frontier.
+ * Called by all threads; sh->frontier_size is valid on return.
+ */
+static void ds_gather(ds_thread_t *th)
+{
+    ds_shared_t *sh = th->sh;
+    ds_bucket_t *b;
+    eid_t total = 0;
+    int t;
+
+    pthread_barrier_wait(&sh->barrier);
+    if ( th->id == 0 ) {
+        for ( t = 0; t < sh->nthreads; t++ ) {
+            sh->threads[t].offset = total;
+            if ( sh->curr < sh->threads[t].nbuckets )
+                total += sh->threads[t].buckets[sh->curr].size;
+        }
+        if ( total > sh->frontier_capacity ) {
+            free(sh->frontier);
+            sh->frontier_capacity = 2 * total;
+            sh->frontier = (vid_t*)malloc_safe(sh->frontier_capacity *
+                                               sizeof(vid_t));
+        }
+        sh->frontier_size = total;
+    }
+    pthread_barrier_wait(&sh->barrier);
+
+    if ( sh->curr < th->nbuckets ) {
+        b = &th->buckets[sh->curr];
+        // An empty bucket may not have its array allocated yet
+        if ( b->size ) {
+            memcpy(sh->frontier + th->offset, b->vertices,
+                   b->size * sizeof(vid_t));
+            b->size = 0;
+        }
+    }
+    pthread_barrier_wait(&sh->barrier);
+}
+
+/**
+ * Selects the first non-empty bucket, or sets sh->done if there is
+ * none, and gathers it. Called by all threads.
+ */
+static void ds_next_bucket(ds_thread_t *th)
+{
+    ds_shared_t *sh = th->sh;
+    ds_thread_t *t;
+    size_t b, next = SIZE_MAX;
+    int i;
+
+    pthread_barrier_wait(&sh->barrier);
+    if ( th->id == 0 ) {
+        // Buckets below the current one are empty; heavy edges never
+        // refill the current one, but it is scanned for safety
+        for ( i = 0; i < sh->nthreads; i++ ) {
+            t = &sh->threads[i];
+            for ( b = sh->curr; b < t->nbuckets && b < next; b++ ) {
+                if ( t->buckets[b].size ) {
+                    next = b;
+                    break;
+                }
+            }
+        }
+        if ( next == SIZE_MAX )
+            sh->done = 1;
+        else
+            sh->curr = next;
+    }
+    ds_gather(th);
+}
+
+/**
+ * Delta-stepping thread function
+ */
+static void* ds_thread(void *arg)
+{
+    ds_thread_t *th = (ds_thread_t*)arg;
+    ds_shared_t *sh = th->sh;
+    eid_t i, begin, end;
+    weight_t du;
+    vid_t u;
+
+    ds_gather(th);
+    while ( !sh->done ) {
+        // Light edges, until the current bucket stops refilling
+        while ( sh->frontier_size > 0 ) {
+            begin = sh->frontier_size * th->id / sh->nthreads;
+            end = sh->frontier_size * (th->id + 1) / sh->nthreads;
+            for ( i = begin; i < end; i++ ) {
+                u = sh->frontier[i];
+                du = ds_load(sh->dist, u);
+                // Skip vertices that moved to a lower bucket since
+                if ( ds_bucket_of(sh, du) != sh->curr )
+                    continue;
+                ds_bucket_append(&th->removed, u);
+                ds_relax(th, u, du, 1);
+            }
+            ds_gather(th);
+        }
+
+        // Heavy edges of the vertices removed from the bucket, whose
+        // distances are now final
+        for ( i = 0; i < th->removed.size; i++ ) {
+            u = th->removed.vertices[i];
+            ds_relax(th, u, ds_load(sh->dist, u), 0);
+        }
+        th->removed.size = 0;
+
+        ds_next_bucket(th);
+    }
+
+    return NULL;
+}
+
+/**
+ * Lowers a predecessor to u if it is larger
+ */
+static inline void ds_pred_min(vid_t *pred, vid_t v, vid_t u)
+{
+    vid_t old = __atomic_load_n(&pred[v], __ATOMIC_RELAXED);
+
+    while ( u < old ) {
+        if ( __atomic_compare_exchange_n(&pred[v], &old, u, 1,
+                                         __ATOMIC_RELAXED, __ATOMIC_RELAXED) )
+            return;
+    }
+}
+
+/**
+ * Predecessor thread function: for each edge (u,v) of a vertex range
+ * that gives v its final distance from a strictly closer u, offers u
+ * as the predecessor of v
+ */
+static void* ds_pred_thread(void *arg)
+{
+    ds_thread_t *th = (ds_thread_t*)arg;
+    csr_t *g = th->sh->g;
+    weight_t *dist = (weight_t*)th->sh->dist;
+    vid_t u, v;
+    eid_t e;
+
+    for ( u = th->vbegin; u < th->vend; u++ ) {
+        if ( dist[u] == INFINITY )
+            continue;
+        for ( e = g->offsets[u]; e < g->offsets[u+1]; e++ ) {
+            v = g->neighbors[e];
+            if ( dist[u] < dist[v] && dist[u] + g->weights[e] == dist[v] )
+                ds_pred_min(th->sh->pred, v, u);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Sets the predecessors of the vertices that are only reached at their
+ * final distance from vertices at the same distance (through zero
+ * weight edges, or edges absorbed by rounding), with a breadth-first
+ * search from the vertices that already have one
+ */
+static void ds_pred_ties(csr_t *g, vid_t s, const weight_t *dist, vid_t *pred)
+{
+    vid_t u, v, head = 0, tail = 0, *queue;
+    eid_t e;
+
+    for ( v = 0; v < g->nvertices; v++ )
+        if ( v != s && dist[v] != INFINITY && pred[v] == VID_MAX )
+            break;
+    if ( v == g->nvertices )
+        return;
+
+    queue = (vid_t*)malloc_safe(g->nvertices * sizeof(vid_t));
+    for ( v = 0; v < g->nvertices; v++ )
+        if ( pred[v] != VID_MAX )
+            queue[tail++] = v;
+
+    while ( head < tail ) {
+        u = queue[head++];
+        for ( e = g->offsets[u]; e < g->offsets[u+1]; e++ ) {
+            v = g->neighbors[e];
+            if ( pred[v] == VID_MAX && dist[u] + g->weights[e] == dist[v] ) {
+                pred[v] = u;
+                queue[tail++] = v;
+            }
+        }
+    }
+
+    free(queue);
+}
+
+/**
+ * Computes a bucket width from graph statistics: the maximum edge
+ * weight divided by the average out-degree, so that a bucket holds
+ * about one light edge per vertex on random weights
+ * @param stats pointer to statistics info (as filled by csr_build()
+ *        or adjlist_build())
+ * @return bucket width
+ */
+weight_t delta_stepping_delta(const adjlist_stats_t *stats)
+{
+    double avg_degree = stats->nvertices ?
+                        (double)stats->nedges / stats->nvertices : 0.0;
+
+    if ( stats->max_edge_weight <= 0 )
+        return 1.0;
+    if ( avg_degree < 1.0 )
+        avg_degree = 1.0;
+
+    return (weight_t)(stats->max_edge_weight / avg_degree);
+}
+
+/**
+ * Runs delta-stepping from a source vertex. Distances match those of
+ * dijkstra_csr(); unreached vertices get an infinite distance and
+ * are their own predecessors.
+ * @param g pointer to CSR graph (non-negative weights)
+ * @param s source vertex
+ * @param delta bucket width (> 0, see delta_stepping_delta())
+ * @param pred predecessor array
+ * @param dist distance array
+ * @param nthreads number of threads (<=0 for all online processors)
+ */
+void delta_stepping_csr(csr_t *g,
+                        vid_t s,
+                        weight_t delta,
+                        vid_t *pred,
+                        weight_t *dist,
+                        int nthreads)
+{
+    ds_shared_t sh;
+    ds_thread_t *threads;
+    vid_t v;
+    int i;
+
+    if ( nthreads <= 0 )
+        nthreads = parallel_default_nthreads();
+
+    for ( v = 0; v < g->nvertices; v++ ) {
+        dist[v] = INFINITY;
+        pred[v] = VID_MAX;
+    }
+    dist[s] = 0;
+    pred[s] = s;
+
+    sh.g = g;
+    sh.delta = delta;
+    sh.dist = (uint32_t*)dist;
+    sh.pred = pred;
+    sh.nthreads = nthreads;
+    sh.frontier = NULL;
+    sh.frontier_size = 0;
+    sh.frontier_capacity = 0;
+    sh.curr = 0;
+    sh.done = 0;
+    pthread_barrier_init(&sh.barrier, NULL, nthreads);
+
+    threads = (ds_thread_t*)malloc_safe(nthreads * sizeof(ds_thread_t));
+    memset(threads, 0, nthreads * sizeof(ds_thread_t));
+    for ( i = 0; i < nthreads; i++ ) {
+        threads[i].id = i;
+        threads[i].sh = &sh;
+        threads[i].vbegin = parallel_split_offsets(g->offsets, g->nvertices,
+                                                   nthreads, i);
+        threads[i].vend = parallel_split_offsets(g->offsets, g->nvertices,
+                                                 nthreads, i+1);
+    }
+    sh.threads = threads;
+    ds_bucket_append(ds_thread_bucket(&threads[0], 0), s);
+
+    parallel_run(ds_thread, threads, sizeof(ds_thread_t), nthreads);
+
+    // Predecessors, from the final distances
+    parallel_run(ds_pred_thread, threads, sizeof(ds_thread_t), nthreads);
+    ds_pred_ties(g, s, dist, pred);
+    for ( v = 0; v < g->nvertices; v++ )
+        if ( pred[v] == VID_MAX )
+            pred[v] = v;
+
+    for ( i = 0; i < nthreads; i++ ) {
+        while ( threads[i].nbuckets > 0 )
+            free(threads[i].buckets[--threads[i].nbuckets].vertices);
+        free(threads[i].buckets);
+        free(threads[i].removed.vertices);
+    }
+    free(threads);
+    free(sh.frontier);
+    pthread_barrier_destroy(&sh.barrier);
+}
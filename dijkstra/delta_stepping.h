@@ -0,0 +1,36 @@
+/**
+ * @file
+ * Parallel delta-stepping single-source shortest paths.
+ *
+ * Tentative distances are grouped in buckets of width delta and the
+ * buckets are processed in increasing order. Within a bucket, the
+ * threads relax the light edges (weight <= delta) of its vertices
+ * until it stops refilling; the heavy edges of every vertex removed
+ * from the bucket are then relaxed once. Distances are lowered with an
+ * atomic minimum, and each thread pushes the vertices it improves to
+ * its own buckets, which are gathered into a shared frontier between
+ * phases.
+ *
+ * Distances are exactly those of dijkstra(). Predecessors are derived
+ * from the final distances afterwards, picking the smallest vertex id
+ * among the tied candidates, so they do not depend on the thread
+ * schedule (but may differ from dijkstra() on ties).
+ */
+
+#ifndef DELTA_STEPPING_H_
+#define DELTA_STEPPING_H_
+
+#include "graph/adjlist.h"
+#include "graph/csr.h"
+#include "graph/graph.h"
+
+extern weight_t delta_stepping_delta(const adjlist_stats_t *stats);
+
+extern void delta_stepping_csr(csr_t *g,
+                               vid_t s,
+                               weight_t delta,
+                               vid_t *pred,
+                               weight_t *dist,
+                               int nthreads);
+
+#endif
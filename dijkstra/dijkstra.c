@@ -20,38 +20,106 @@
  * @param dist distance array
  */ 
 void dijkstra_alloc_arrays(adjlist_t *al, 
-                           unsigned int **pred, 
+                           vid_t **pred, 
                            weight_t **dist)
 {
-    *pred = (unsigned int*)malloc_safe(al->nvertices * sizeof(unsigned int));
+    *pred = (vid_t*)malloc_safe(al->nvertices * sizeof(vid_t));
     *dist = (weight_t*)malloc_safe(al->nvertices * sizeof(weight_t));
 }
 
 /**
- * Initialize Dijsktra structures. 
- * The <key,value> pairs held by each node of the priority queue will be 
- * <dist[v],v>.
- *
- * @param al graph's adjacency list
- * @param s source vertex id
+ * Allocate Dijsktra arrays for a CSR graph
+ * @param g CSR graph
  * @param pred predecessor array
  * @param dist distance array
- * @return pointer to binary heap
  */ 
-bheap_t* dijkstra_init(adjlist_t *al, 
-                       unsigned int s,
-                       unsigned int *pred, 
-                       weight_t *dist)
+void dijkstra_alloc_arrays_csr(csr_t *g, 
+                               vid_t **pred, 
+                               weight_t **dist)
+{
+    *pred = (vid_t*)malloc_safe(g->nvertices * sizeof(vid_t));
+    *dist = (weight_t*)malloc_safe(g->nvertices * sizeof(weight_t));
+}
+
+/**
+ * Allocate Dijsktra arrays for a compressed CSR graph
+ * @param g compressed CSR graph
+ * @param pred predecessor array
+ * @param dist distance array
+ */ 
+void dijkstra_alloc_arrays_ccsr(ccsr_t *g, 
+                                vid_t **pred, 
+                                weight_t **dist)
+{
+    *pred = (vid_t*)malloc_safe(g->nvertices * sizeof(vid_t));
+    *dist = (weight_t*)malloc_safe(g->nvertices * sizeof(weight_t));
+}
+
+/**
+ * Allocate Dijsktra arrays for a dynamic graph
+ * @param g dynamic graph
+ * @param pred predecessor array
+ * @param dist distance array
+ */ 
+void dijkstra_alloc_arrays_dyn(dyngraph_t *g, 
+                               vid_t **pred, 
+                               weight_t **dist)
+{
+    *pred = (vid_t*)malloc_safe(g->nvertices * sizeof(vid_t));
+    *dist = (weight_t*)malloc_safe(g->nvertices * sizeof(weight_t));
+}
+
+#ifdef DIJKSTRA_DHEAP
+
+/**
+ * Creates a heap holding all vertices at distance INFINITY
+ */ 
+static inline dijkstra_pq_t* pq_create(vid_t nvertices)
+{
+    dheap_t *heap = dh_create(nvertices);
+    dh_fill(heap, INFINITY);
+    return heap;
+}
+
+/**
+ * Removes the vertex at minimum distance
+ */ 
+static inline vid_t pq_extract_min(dijkstra_pq_t *heap, weight_t *key)
+{
+    return dh_extract_min(heap, key);
+}
+
+/**
+ * Lowers the distance of a vertex in the heap
+ */ 
+static inline void pq_decrease_key(dijkstra_pq_t *heap, 
+                                   vid_t v, 
+                                   weight_t key)
 {
-    unsigned int i;
+    dh_decrease_key(heap, v, key);
+}
+
+/**
+ * Deallocates the heap
+ */ 
+static inline void pq_destroy(dijkstra_pq_t *heap)
+{
+    dh_destroy(heap);
+}
+
+#else
+
+/**
+ * Creates a heap holding all vertices at distance INFINITY
+ */ 
+static inline dijkstra_pq_t* pq_create(vid_t nvertices)
+{
+    vid_t i;
     bh_node_t new;
 
-    bheap_t *heap = bh_create(al->nvertices);
+    bheap_t *heap = bh_create(nvertices);
 
-    for ( i = 0; i < al->nvertices; i++ ) {
-        pred[i] = i;
-        dist[i] = INFINITY;
-        
+    for ( i = 0; i < nvertices; i++ ) {
         new.value = i;
         new.key = INFINITY;
 
@@ -59,32 +127,163 @@ bheap_t* dijkstra_init(adjlist_t *al,
     }
     
     bh_build_min_heap(heap);
-      
-    bh_decrease_key(heap, s, 0); 
+
+    return heap;
+}
+
+/**
+ * Removes the vertex at minimum distance
+ */ 
+static inline vid_t pq_extract_min(dijkstra_pq_t *heap, weight_t *key)
+{
+    bh_node_t *min = bh_extract_min(heap);
+    *key = min->key;
+    return min->value;
+}
+
+/**
+ * Lowers the distance of a vertex in the heap
+ */ 
+static inline void pq_decrease_key(dijkstra_pq_t *heap, 
+                                   vid_t v, 
+                                   weight_t key)
+{
+    bh_decrease_key(heap, v, key);
+}
+
+/**
+ * Deallocates the heap
+ */ 
+static inline void pq_destroy(dijkstra_pq_t *heap)
+{
+    bh_destroy(heap);
+}
+
+#endif
+
+/**
+ * Sets all distances to INFINITY, except that of the source
+ */ 
+static void dijkstra_reset(vid_t nvertices, 
+                           vid_t s, 
+                           vid_t *pred, 
+                           weight_t *dist)
+{
+    vid_t i;
+
+    for ( i = 0; i < nvertices; i++ ) {
+        pred[i] = i;
+        dist[i] = INFINITY;
+    }
     dist[s] = (weight_t)0;
+}
+
+/**
+ * Fills the heap with all vertices at distance INFINITY and
+ * sets the source distance to 0
+ * @param nvertices number of graph vertices
+ * @param s source vertex id
+ * @param pred predecessor array
+ * @param dist distance array
+ * @return pointer to priority queue
+ */ 
+static dijkstra_pq_t* dijkstra_init_common(vid_t nvertices, 
+                                          vid_t s,
+                                          vid_t *pred, 
+                                          weight_t *dist)
+{
+    dijkstra_pq_t *heap = pq_create(nvertices);
+
+    dijkstra_reset(nvertices, s, pred, dist);
+    pq_decrease_key(heap, s, 0); 
 
     return heap;
 }
 
+/**
+ * Initialize Dijsktra structures. 
+ * The <key,value> pairs held by each node of the priority queue will be 
+ * <dist[v],v>.
+ *
+ * @param al graph's adjacency list
+ * @param s source vertex id
+ * @param pred predecessor array
+ * @param dist distance array
+ * @return pointer to priority queue
+ */ 
+dijkstra_pq_t* dijkstra_init(adjlist_t *al, 
+                             vid_t s,
+                             vid_t *pred, 
+                             weight_t *dist)
+{
+    return dijkstra_init_common(al->nvertices, s, pred, dist);
+}
+
+/**
+ * Initialize Dijsktra structures for a CSR graph
+ * @param g CSR graph
+ * @param s source vertex id
+ * @param pred predecessor array
+ * @param dist distance array
+ * @return pointer to priority queue
+ */ 
+dijkstra_pq_t* dijkstra_init_csr(csr_t *g, 
+                                 vid_t s,
+                                 vid_t *pred, 
+                                 weight_t *dist)
+{
+    return dijkstra_init_common(g->nvertices, s, pred, dist);
+}
+
+/**
+ * Initialize Dijsktra structures for a compressed CSR graph
+ * @param g compressed CSR graph
+ * @param s source vertex id
+ * @param pred predecessor array
+ * @param dist distance array
+ * @return pointer to priority queue
+ */ 
+dijkstra_pq_t* dijkstra_init_ccsr(ccsr_t *g, 
+                                  vid_t s,
+                                  vid_t *pred, 
+                                  weight_t *dist)
+{
+    return dijkstra_init_common(g->nvertices, s, pred, dist);
+}
+
+/**
+ * Initialize Dijsktra structures for a dynamic graph
+ * @param g dynamic graph
+ * @param s source vertex id
+ * @param pred predecessor array
+ * @param dist distance array
+ * @return pointer to priority queue
+ */ 
+dijkstra_pq_t* dijkstra_init_dyn(dyngraph_t *g, 
+                                 vid_t s,
+                                 vid_t *pred, 
+                                 weight_t *dist)
+{
+    return dijkstra_init_common(g->nvertices, s, pred, dist);
+}
+
 /**
  * Run Dijkstra's algorithm
  * @param al graph's adjacency list
  * @param s source vertex id
- * @param heap binary heap
+ * @param heap priority queue
  * @param pred predecessor array
  * @param dist distance array
  */
 void dijkstra(adjlist_t *al, 
-              unsigned int s,
-              bheap_t *heap, 
-              unsigned int *pred, 
+              vid_t s,
+              dijkstra_pq_t *heap, 
+              vid_t *pred, 
               weight_t *dist)
 {
-    unsigned int u;
-    index_t v_hindex;
-    weight_t distv, sum;
+    vid_t u;
+    weight_t ukey, distv, sum;
     node_t *v;
-    bh_node_t *min;
 
     assert(heap);
     assert(heap->capacity > 0);
@@ -93,19 +292,17 @@ void dijkstra(adjlist_t *al,
 
     while ( heap->curr_size > 0 ) {
 
-        min = bh_extract_min(heap);
-        u = min->value;
+        u = pq_extract_min(heap, &ukey);
 
-        /*fprintf(stderr, "Extracted %u with distance %f\n", u, min->key);*/
+        /*fprintf(stderr, "Extracted %" PRIvid " with distance %f\n", u, ukey);*/
     
-        if( min->key < INFINITY ) {
+        if( ukey < INFINITY ) {
             for ( v = al->adj[u]; v != NULL; v = v->next ) {
-                v_hindex = heap->where_in_heap[v->id];
-                distv = heap->node_array[v_hindex].key;
+                distv = dist[v->id];
 
-                sum = min->key + v->weight;
+                sum = ukey + v->weight;
                 if ( distv > sum ) {
-                    bh_decrease_key(heap, v->id, sum);
+                    pq_decrease_key(heap, v->id, sum);
                     pred[v->id] = u; 
                     dist[v->id] = sum;  
                 }
@@ -114,17 +311,478 @@ void dijkstra(adjlist_t *al,
     }
 }
 
+/**
+ * Run Dijkstra's algorithm on a CSR graph
+ * @param g CSR graph
+ * @param s source vertex id
+ * @param heap priority queue
+ * @param pred predecessor array
+ * @param dist distance array
+ */
+void dijkstra_csr(csr_t *g, 
+                  vid_t s,
+                  dijkstra_pq_t *heap, 
+                  vid_t *pred, 
+                  weight_t *dist)
+{
+    vid_t u, v;
+    eid_t e, end;
+    weight_t ukey, distv, sum;
+
+    assert(heap);
+    assert(heap->capacity > 0);
+    assert(dist);
+    assert(pred);
+
+    while ( heap->curr_size > 0 ) {
+
+        u = pq_extract_min(heap, &ukey);
+
+        if( ukey < INFINITY ) {
+            end = g->offsets[u+1];
+            for ( e = g->offsets[u]; e < end; e++ ) {
+                v = g->neighbors[e];
+                distv = dist[v];
+
+                sum = ukey + g->weights[e];
+                if ( distv > sum ) {
+                    pq_decrease_key(heap, v, sum);
+                    pred[v] = u; 
+                    dist[v] = sum;  
+                }
+            }
+        } 
+    }
+}
+
+/**
+ * Run Dijkstra's algorithm on a compressed CSR graph, decoding the 
+ * neighbors of each extracted vertex on the fly
+ * @param g compressed CSR graph
+ * @param s source vertex id
+ * @param heap priority queue
+ * @param pred predecessor array
+ * @param dist distance array
+ */
+void dijkstra_ccsr(ccsr_t *g, 
+                   vid_t s,
+                   dijkstra_pq_t *heap, 
+                   vid_t *pred, 
+                   weight_t *dist)
+{
+    vid_t u, v;
+    weight_t ukey, distv, sum, w;
+    ccsr_iter_t it;
+
+    assert(heap);
+    assert(heap->capacity > 0);
+    assert(dist);
+    assert(pred);
+
+    while ( heap->curr_size > 0 ) {
+
+        u = pq_extract_min(heap, &ukey);
+
+        if( ukey < INFINITY ) {
+            ccsr_iter_begin(g, u, &it);
+            while ( ccsr_iter_next(&it, &v, &w) ) {
+                distv = dist[v];
+
+                sum = ukey + w;
+                if ( distv > sum ) {
+                    pq_decrease_key(heap, v, sum);
+                    pred[v] = u; 
+                    dist[v] = sum;  
+                }
+            }
+        } 
+    }
+}
+
+/**
+ * Run Dijkstra's algorithm on a dynamic graph
+ * @param g dynamic graph
+ * @param s source vertex id
+ * @param heap priority queue
+ * @param pred predecessor array
+ * @param dist distance array
+ */
+void dijkstra_dyn(dyngraph_t *g, 
+                  vid_t s,
+                  dijkstra_pq_t *heap, 
+                  vid_t *pred, 
+                  weight_t *dist)
+{
+    vid_t u, v;
+    eid_t e, deg;
+    weight_t ukey, distv, sum;
+    const dyn_edge_t *edges;
+
+    assert(heap);
+    assert(heap->capacity > 0);
+    assert(dist);
+    assert(pred);
+
+    while ( heap->curr_size > 0 ) {
+
+        u = pq_extract_min(heap, &ukey);
+
+        if( ukey < INFINITY ) {
+            edges = g->rows[u].edges;
+            deg = g->rows[u].deg;
+            for ( e = 0; e < deg; e++ ) {
+                v = edges[e].id;
+                distv = dist[v];
+
+                sum = ukey + edges[e].weight;
+                if ( distv > sum ) {
+                    pq_decrease_key(heap, v, sum);
+                    pred[v] = u; 
+                    dist[v] = sum;  
+                }
+            }
+        } 
+    }
+}
+
+/**
+ * Run Dijkstra's algorithm with a radix heap. Vertices are pushed 
+ * again whenever their distance drops, and stale entries are skipped 
+ * when popped. Needs no separate initialization.
+ * @param al graph's adjacency list
+ * @param s source vertex id
+ * @param pred predecessor array
+ * @param dist distance array
+ */
+void dijkstra_radix(adjlist_t *al, 
+                    vid_t s,
+                    vid_t *pred, 
+                    weight_t *dist)
+{
+    vid_t u;
+    rh_key_t key;
+    weight_t ukey, sum;
+    node_t *v;
+    rheap_t *heap = rh_create();
+
+    dijkstra_reset(al->nvertices, s, pred, dist);
+    rh_push(heap, rh_float_key(0), s);
+
+    while ( !rh_empty(heap) ) {
+        u = rh_pop(heap, &key);
+        ukey = rh_key_float(key);
+        if ( ukey > dist[u] )
+            continue;
+
+        for ( v = al->adj[u]; v != NULL; v = v->next ) {
+            sum = ukey + v->weight;
+            if ( dist[v->id] > sum ) {
+                rh_push(heap, rh_float_key(sum), v->id);
+                pred[v->id] = u; 
+                dist[v->id] = sum;  
+            }
+        }
+    }
+
+    rh_destroy(heap);
+}
+
+/**
+ * Run Dijkstra's algorithm with a radix heap on a CSR graph
+ * @param g CSR graph
+ * @param s source vertex id
+ * @param pred predecessor array
+ * @param dist distance array
+ */
+void dijkstra_radix_csr(csr_t *g, 
+                        vid_t s,
+                        vid_t *pred, 
+                        weight_t *dist)
+{
+    vid_t u, v;
+    eid_t e, end;
+    rh_key_t key;
+    weight_t ukey, sum;
+    rheap_t *heap = rh_create();
+
+    dijkstra_reset(g->nvertices, s, pred, dist);
+    rh_push(heap, rh_float_key(0), s);
+
+    while ( !rh_empty(heap) ) {
+        u = rh_pop(heap, &key);
+        ukey = rh_key_float(key);
+        if ( ukey > dist[u] )
+            continue;
+
+        end = g->offsets[u+1];
+        for ( e = g->offsets[u]; e < end; e++ ) {
+            v = g->neighbors[e];
+            sum = ukey + g->weights[e];
+            if ( dist[v] > sum ) {
+                rh_push(heap, rh_float_key(sum), v);
+                pred[v] = u; 
+                dist[v] = sum;  
+            }
+        }
+    }
+
+    rh_destroy(heap);
+}
+
+/**
+ * Run Dijkstra's algorithm with a push-only heap: a vertex is pushed 
+ * every time its distance drops, with no position index, and stale 
+ * entries are skipped when popped. Only reachable vertices enter the 
+ * heap, whose size follows the search frontier. Needs no separate 
+ * initialization.
+ * @param al graph's adjacency list
+ * @param s source vertex id
+ * @param pred predecessor array
+ * @param dist distance array
+ */
+void dijkstra_lazy(adjlist_t *al, 
+                   vid_t s,
+                   vid_t *pred, 
+                   weight_t *dist)
+{
+    vid_t u;
+    weight_t ukey, sum;
+    node_t *v;
+    lheap_t *heap = lh_create(0);
+
+    dijkstra_reset(al->nvertices, s, pred, dist);
+    lh_push(heap, s, 0);
+
+    while ( !lh_empty(heap) ) {
+        u = lh_pop(heap, &ukey);
+        if ( ukey > dist[u] )
+            continue;
+
+        for ( v = al->adj[u]; v != NULL; v = v->next ) {
+            sum = ukey + v->weight;
+            if ( dist[v->id] > sum ) {
+                lh_push(heap, v->id, sum);
+                pred[v->id] = u; 
+                dist[v->id] = sum;  
+            }
+        }
+    }
+
+    lh_destroy(heap);
+}
+
+/**
+ * Run Dijkstra's algorithm with a push-only heap on a CSR graph
+ * @param g CSR graph
+ * @param s source vertex id
+ * @param pred predecessor array
+ * @param dist distance array
+ */
+void dijkstra_lazy_csr(csr_t *g, 
+                       vid_t s,
+                       vid_t *pred, 
+                       weight_t *dist)
+{
+    vid_t u, v;
+    eid_t e, end;
+    weight_t ukey, sum;
+    lheap_t *heap = lh_create(0);
+
+    dijkstra_reset(g->nvertices, s, pred, dist);
+    lh_push(heap, s, 0);
+
+    while ( !lh_empty(heap) ) {
+        u = lh_pop(heap, &ukey);
+        if ( ukey > dist[u] )
+            continue;
+
+        end = g->offsets[u+1];
+        for ( e = g->offsets[u]; e < end; e++ ) {
+            v = g->neighbors[e];
+            sum = ukey + g->weights[e];
+            if ( dist[v] > sum ) {
+                lh_push(heap, v, sum);
+                pred[v] = u; 
+                dist[v] = sum;  
+            }
+        }
+    }
+
+    lh_destroy(heap);
+}
+
+/**
+ * Returns whether a weight fits Dial's algorithm: a non-negative 
+ * integer no larger than DIJKSTRA_DIAL_MAX_WEIGHT
+ */ 
+static inline int dial_weight(weight_t w)
+{
+    return w >= 0 && w <= DIJKSTRA_DIAL_MAX_WEIGHT && w == floorf(w);
+}
+
+/**
+ * Checks whether Dial's algorithm applies: the maximum edge weight 
+ * gathered while reading the graph (or by adjlist_analyze()) rules out
+ * large weights at once, then every weight must be an integer
+ * @param al graph's adjacency list
+ * @param stats graph statistics
+ * @return 1 if all weights are small non-negative integers, 0 otherwise
+ */ 
+int dijkstra_dial_applicable(adjlist_t *al, const adjlist_stats_t *stats)
+{
+    vid_t u;
+    node_t *v;
+
+    if ( stats->max_edge_weight > DIJKSTRA_DIAL_MAX_WEIGHT )
+        return 0;
+    for ( u = 0; u < al->nvertices; u++ )
+        for ( v = al->adj[u]; v != NULL; v = v->next )
+            if ( !dial_weight(v->weight) )
+                return 0;
+
+    return 1;
+}
+
+/**
+ * Checks whether Dial's algorithm applies to a CSR graph
+ * @param g CSR graph
+ * @param stats graph statistics
+ * @return 1 if all weights are small non-negative integers, 0 otherwise
+ */ 
+int dijkstra_dial_applicable_csr(csr_t *g, const adjlist_stats_t *stats)
+{
+    eid_t e;
+
+    if ( stats->max_edge_weight > DIJKSTRA_DIAL_MAX_WEIGHT )
+        return 0;
+    for ( e = 0; e < g->nedges; e++ )
+        if ( !dial_weight(g->weights[e]) )
+            return 0;
+
+    return 1;
+}
+
+/**
+ * Allocates the integer distances of Dial's algorithm
+ */ 
+static bq_key_t* dial_alloc(vid_t nvertices, vid_t s)
+{
+    vid_t i;
+    bq_key_t *idist = (bq_key_t*)malloc(nvertices * sizeof(bq_key_t));
+    if ( !idist ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+
+    for ( i = 0; i < nvertices; i++ )
+        idist[i] = UINT64_MAX;
+    idist[s] = 0;
+
+    return idist;
+}
+
+/**
+ * Run Dial's algorithm: Dijkstra's algorithm with a bucket queue, for
+ * small integer weights (see dijkstra_dial_applicable()). Distances are
+ * summed exactly as integers and rounded to weight_t once, so they 
+ * match dijkstra() as long as they stay below 2^24. Needs no separate 
+ * initialization.
+ * @param al graph's adjacency list
+ * @param s source vertex id
+ * @param max_weight maximum edge weight
+ * @param pred predecessor array
+ * @param dist distance array
+ */
+void dijkstra_dial(adjlist_t *al, 
+                   vid_t s,
+                   unsigned int max_weight,
+                   vid_t *pred, 
+                   weight_t *dist)
+{
+    vid_t u;
+    bq_key_t ukey, sum, *idist = dial_alloc(al->nvertices, s);
+    node_t *v;
+    bqueue_t *q = bq_create(max_weight);
+
+    dijkstra_reset(al->nvertices, s, pred, dist);
+    bq_push(q, 0, s);
+
+    while ( !bq_empty(q) ) {
+        u = bq_pop(q, &ukey);
+        if ( ukey > idist[u] )
+            continue;
+        dist[u] = (weight_t)ukey;
+
+        for ( v = al->adj[u]; v != NULL; v = v->next ) {
+            sum = ukey + (bq_key_t)v->weight;
+            if ( idist[v->id] > sum ) {
+                bq_push(q, sum, v->id);
+                pred[v->id] = u; 
+                idist[v->id] = sum;  
+            }
+        }
+    }
+
+    bq_destroy(q);
+    free(idist);
+}
+
+/**
+ * Run Dial's algorithm on a CSR graph
+ * @param g CSR graph
+ * @param s source vertex id
+ * @param max_weight maximum edge weight
+ * @param pred predecessor array
+ * @param dist distance array
+ */
+void dijkstra_dial_csr(csr_t *g, 
+                       vid_t s,
+                       unsigned int max_weight,
+                       vid_t *pred, 
+                       weight_t *dist)
+{
+    vid_t u, v;
+    eid_t e, end;
+    bq_key_t ukey, sum, *idist = dial_alloc(g->nvertices, s);
+    bqueue_t *q = bq_create(max_weight);
+
+    dijkstra_reset(g->nvertices, s, pred, dist);
+    bq_push(q, 0, s);
+
+    while ( !bq_empty(q) ) {
+        u = bq_pop(q, &ukey);
+        if ( ukey > idist[u] )
+            continue;
+        dist[u] = (weight_t)ukey;
+
+        end = g->offsets[u+1];
+        for ( e = g->offsets[u]; e < end; e++ ) {
+            v = g->neighbors[e];
+            sum = ukey + (bq_key_t)g->weights[e];
+            if ( idist[v] > sum ) {
+                bq_push(q, sum, v);
+                pred[v] = u; 
+                idist[v] = sum;  
+            }
+        }
+    }
+
+    bq_destroy(q);
+    free(idist);
+}
+
 /**
  * De-allocate data structures
  * @param pred predecessor array
  * @param dist distance array
- * @param heap binary heap
+ * @param heap priority queue (or NULL)
  */ 
-void dijkstra_finalize(unsigned int *pred, 
+void dijkstra_finalize(vid_t *pred, 
                        weight_t *dist, 
-                       bheap_t *heap)
+                       dijkstra_pq_t *heap)
 {
-    bh_destroy(heap);
+    if ( heap )
+        pq_destroy(heap);
     free(pred);
     free(dist);
 }
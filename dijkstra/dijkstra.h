@@ -6,25 +6,134 @@
 #define DIJKSTRA_H_
 
 #include "binary_heap/binary_heap.h"
+#include "bucket_queue/bucket_queue.h"
+#include "binary_heap/lazy_heap.h"
 #include "graph/adjlist.h"
+#include "graph/ccsr.h"
+#include "graph/csr.h"
+#include "graph/dyngraph.h"
 #include "graph/graph.h"
+#include "radix_heap/radix_heap.h"
+
+/**
+ * Largest edge weight handled by Dial's algorithm, which keeps one 
+ * bucket per distance in a window that wide
+ */ 
+#ifndef DIJKSTRA_DIAL_MAX_WEIGHT
+#define DIJKSTRA_DIAL_MAX_WEIGHT 65536
+#endif
+
+/**
+ * Priority queue used by Dijkstra's algorithm: the binary heap by 
+ * default, or the d-ary heap when built with -DDIJKSTRA_DHEAP 
+ * (arity set with -DDHEAP_ARITY)
+ */ 
+#ifdef DIJKSTRA_DHEAP
+#include "dary_heap/dary_heap.h"
+typedef dheap_t dijkstra_pq_t;
+#else
+typedef bheap_t dijkstra_pq_t;
+#endif
 
 extern void dijkstra_alloc_arrays(adjlist_t *al, 
-                                  unsigned int **pred, 
+                                  vid_t **pred, 
                                   weight_t **dist);
 
-extern bheap_t* dijkstra_init(adjlist_t *al, 
-                              unsigned int s, 
-                              unsigned int *pred, 
-                              weight_t *dist);
+extern void dijkstra_alloc_arrays_csr(csr_t *g, 
+                                      vid_t **pred, 
+                                      weight_t **dist);
+
+extern void dijkstra_alloc_arrays_ccsr(ccsr_t *g, 
+                                       vid_t **pred, 
+                                       weight_t **dist);
+
+extern void dijkstra_alloc_arrays_dyn(dyngraph_t *g, 
+                                      vid_t **pred, 
+                                      weight_t **dist);
+
+extern dijkstra_pq_t* dijkstra_init(adjlist_t *al, 
+                                    vid_t s, 
+                                    vid_t *pred, 
+                                    weight_t *dist);
+
+extern dijkstra_pq_t* dijkstra_init_csr(csr_t *g, 
+                                        vid_t s, 
+                                        vid_t *pred, 
+                                        weight_t *dist);
+
+extern dijkstra_pq_t* dijkstra_init_ccsr(ccsr_t *g, 
+                                         vid_t s, 
+                                         vid_t *pred, 
+                                         weight_t *dist);
+
+extern dijkstra_pq_t* dijkstra_init_dyn(dyngraph_t *g, 
+                                        vid_t s, 
+                                        vid_t *pred, 
+                                        weight_t *dist);
 
 extern void dijkstra(adjlist_t *al, 
-                     unsigned int s,
-                     bheap_t *heap, 
-                     unsigned int *pred, 
+                     vid_t s,
+                     dijkstra_pq_t *heap, 
+                     vid_t *pred, 
                      weight_t *dist);
 
-extern void dijkstra_finalize(unsigned int *pred, 
+extern void dijkstra_csr(csr_t *g, 
+                         vid_t s,
+                         dijkstra_pq_t *heap, 
+                         vid_t *pred, 
+                         weight_t *dist);
+
+extern void dijkstra_ccsr(ccsr_t *g, 
+                          vid_t s,
+                          dijkstra_pq_t *heap, 
+                          vid_t *pred, 
+                          weight_t *dist);
+
+extern void dijkstra_dyn(dyngraph_t *g, 
+                         vid_t s,
+                         dijkstra_pq_t *heap, 
+                         vid_t *pred, 
+                         weight_t *dist);
+
+extern void dijkstra_radix(adjlist_t *al, 
+                           vid_t s,
+                           vid_t *pred, 
+                           weight_t *dist);
+
+extern void dijkstra_radix_csr(csr_t *g, 
+                               vid_t s,
+                               vid_t *pred, 
+                               weight_t *dist);
+
+extern void dijkstra_lazy(adjlist_t *al, 
+                          vid_t s,
+                          vid_t *pred, 
+                          weight_t *dist);
+
+extern void dijkstra_lazy_csr(csr_t *g, 
+                              vid_t s,
+                              vid_t *pred, 
+                              weight_t *dist);
+
+extern int dijkstra_dial_applicable(adjlist_t *al, 
+                                    const adjlist_stats_t *stats);
+
+extern int dijkstra_dial_applicable_csr(csr_t *g, 
+                                        const adjlist_stats_t *stats);
+
+extern void dijkstra_dial(adjlist_t *al, 
+                          vid_t s,
+                          unsigned int max_weight,
+                          vid_t *pred, 
+                          weight_t *dist);
+
+extern void dijkstra_dial_csr(csr_t *g, 
+                              vid_t s,
+                              unsigned int max_weight,
+                              vid_t *pred, 
+                              weight_t *dist);
+
+extern void dijkstra_finalize(vid_t *pred, 
                               weight_t *dist, 
-                              bheap_t *heap);
+                              dijkstra_pq_t *heap);
 #endif
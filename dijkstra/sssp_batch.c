@@ -0,0 +1,144 @@
+/**
+ * @file
+ * Multi-source shortest paths on a pool of threads
+ */ 
+
+#include "sssp_batch.h"
+#include "graph/parallel.h"
+#include "util/util.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Per-thread arguments, all pointing to the same batch
+ */ 
+typedef struct sssp_batch_targs_st {
+    adjlist_t *al; //!< adjacency list (or NULL)
+    csr_t *g; //!< CSR graph (or NULL)
+    const vid_t *sources; //!< source vertices
+    vid_t nsources; //!< number of sources
+    vid_t *next; //!< index of the next pending source
+    sssp_batch_fn_t fn; //!< per-source callback
+    void *arg; //!< callback argument
+} sssp_batch_targs_t;
+
+/**
+ * Worker thread function: runs the pending sources one at a time in a 
+ * private workspace
+ */ 
+static void* sssp_batch_thread(void *arg)
+{
+    sssp_batch_targs_t *ta = (sssp_batch_targs_t*)arg;
+    sssp_workspace_t *ws;
+    vid_t i;
+
+    ws = sssp_workspace_create(ta->al ? ta->al->nvertices 
+                                      : ta->g->nvertices);
+    while ( (i = __atomic_fetch_add(ta->next, 1, __ATOMIC_RELAXED)) 
+            < ta->nsources ) {
+        if ( ta->al )
+            dijkstra_ws(ta->al, ta->sources[i], ws);
+        else
+            dijkstra_ws_csr(ta->g, ta->sources[i], ws);
+        ta->fn(i, ta->sources[i], ws, ta->arg);
+    }
+    sssp_workspace_destroy(ws);
+
+    return NULL;
+}
+
+/**
+ * Common part of sssp_batch() and sssp_batch_csr()
+ */ 
+static void sssp_batch_run(adjlist_t *al, 
+                           csr_t *g, 
+                           const vid_t *sources, 
+                           vid_t nsources, 
+                           sssp_batch_fn_t fn, 
+                           void *arg, 
+                           int nthreads)
+{
+    sssp_batch_targs_t *targs;
+    vid_t next = 0;
+    int i;
+
+    if ( nthreads <= 0 )
+        nthreads = parallel_default_nthreads();
+    // No idle workspaces
+    if ( (vid_t)nthreads > nsources )
+        nthreads = nsources > 0 ? (int)nsources : 1;
+
+    targs = (sssp_batch_targs_t*)malloc_safe(nthreads * 
+                                             sizeof(sssp_batch_targs_t));
+    for ( i = 0; i < nthreads; i++ ) {
+        targs[i].al = al;
+        targs[i].g = g;
+        targs[i].sources = sources;
+        targs[i].nsources = nsources;
+        targs[i].next = &next;
+        targs[i].fn = fn;
+        targs[i].arg = arg;
+    }
+    parallel_run(sssp_batch_thread, targs, sizeof(sssp_batch_targs_t), 
+                 nthreads);
+    free(targs);
+}
+
+/**
+ * Runs Dijkstra's algorithm from every source of a batch, in parallel
+ * @param al pointer to adjacency list
+ * @param sources source vertices
+ * @param nsources number of sources
+ * @param fn callback called after each search
+ * @param arg callback argument
+ * @param nthreads number of threads (<=0 for all online processors)
+ */ 
+void sssp_batch(adjlist_t *al, 
+                const vid_t *sources, 
+                vid_t nsources, 
+                sssp_batch_fn_t fn, 
+                void *arg, 
+                int nthreads)
+{
+    sssp_batch_run(al, NULL, sources, nsources, fn, arg, nthreads);
+}
+
+/**
+ * Runs Dijkstra's algorithm from every source of a batch, in parallel, 
+ * on a CSR graph
+ * @param g pointer to CSR graph
+ * @param sources source vertices
+ * @param nsources number of sources
+ * @param fn callback called after each search
+ * @param arg callback argument
+ * @param nthreads number of threads (<=0 for all online processors)
+ */ 
+void sssp_batch_csr(csr_t *g, 
+                    const vid_t *sources, 
+                    vid_t nsources, 
+                    sssp_batch_fn_t fn, 
+                    void *arg, 
+                    int nthreads)
+{
+    sssp_batch_run(NULL, g, sources, nsources, fn, arg, nthreads);
+}
+
+/**
+ * Batch callback storing the distances from the i-th source to row i 
+ * of a distance matrix
+ * @param i index of the source in the batch
+ * @param s source vertex
+ * @param ws workspace holding the distances from s
+ * @param arg row-major nsources x nvertices weight_t matrix
+ */ 
+void sssp_batch_store_dist(vid_t i, 
+                           vid_t s, 
+                           const sssp_workspace_t *ws, 
+                           void *arg)
+{
+    weight_t *row = (weight_t*)arg + (size_t)i * ws->nvertices;
+
+    memcpy(row, ws->dist, ws->nvertices * sizeof(weight_t));
+}
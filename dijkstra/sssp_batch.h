@@ -0,0 +1,52 @@
+/**
+ * @file
+ * Multi-source shortest paths on a pool of threads.
+ *
+ * Each thread owns a workspace and repeatedly takes the next pending 
+ * source from a shared counter, so that threads stay busy whatever the 
+ * cost of the individual searches. After each search, a callback gets 
+ * the workspace holding its results; sssp_batch_store_dist() is a 
+ * ready-made callback writing the distances to a row of a matrix.
+ */ 
+
+#ifndef SSSP_BATCH_H_
+#define SSSP_BATCH_H_
+
+#include "sssp_workspace.h"
+#include "graph/adjlist.h"
+#include "graph/csr.h"
+#include "graph/graph.h"
+
+/**
+ * Per-source callback, called from the worker threads (concurrently 
+ * for different sources). The workspace is only valid during the call.
+ * @param i index of the source in the batch
+ * @param s source vertex
+ * @param ws workspace holding the distances and predecessors from s
+ * @param arg user argument
+ */ 
+typedef void (*sssp_batch_fn_t)(vid_t i, 
+                                vid_t s, 
+                                const sssp_workspace_t *ws, 
+                                void *arg);
+
+extern void sssp_batch(adjlist_t *al, 
+                       const vid_t *sources, 
+                       vid_t nsources, 
+                       sssp_batch_fn_t fn, 
+                       void *arg, 
+                       int nthreads);
+
+extern void sssp_batch_csr(csr_t *g, 
+                           const vid_t *sources, 
+                           vid_t nsources, 
+                           sssp_batch_fn_t fn, 
+                           void *arg, 
+                           int nthreads);
+
+extern void sssp_batch_store_dist(vid_t i, 
+                                  vid_t s, 
+                                  const sssp_workspace_t *ws, 
+                                  void *arg);
+
+#endif
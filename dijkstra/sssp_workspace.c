@@ -0,0 +1,319 @@
+/**
+ * @file
+ * Reusable single-source shortest path workspace and queries
+ */ 
+
+#include "sssp_workspace.h"
+#include "util/util.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * Allocates a workspace, with all vertices unreached
+ * @param nvertices number of graph vertices
+ * @return pointer to workspace
+ */ 
+sssp_workspace_t* sssp_workspace_create(vid_t nvertices)
+{
+    vid_t i;
+    sssp_workspace_t *ws = 
+        (sssp_workspace_t*)malloc_safe(sizeof(sssp_workspace_t));
+
+    ws->nvertices = nvertices;
+    ws->dist = (weight_t*)malloc_safe(nvertices * sizeof(weight_t));
+    ws->pred = (vid_t*)malloc_safe(nvertices * sizeof(vid_t));
+    ws->touched = (vid_t*)malloc_safe(nvertices * sizeof(vid_t));
+    ws->ntouched = 0;
+    ws->heap = lh_create(0);
+
+    for ( i = 0; i < nvertices; i++ ) {
+        ws->dist[i] = INFINITY;
+        ws->pred[i] = i;
+    }
+
+    return ws;
+}
+
+/**
+ * Deallocates a workspace
+ * @param ws pointer to workspace
+ */ 
+void sssp_workspace_destroy(sssp_workspace_t *ws)
+{
+    lh_destroy(ws->heap);
+    free(ws->touched);
+    free(ws->pred);
+    free(ws->dist);
+    free(ws);
+}
+
+/**
+ * Marks all vertices unreached again, visiting only the touched ones
+ * @param ws pointer to workspace
+ */ 
+void sssp_workspace_reset(sssp_workspace_t *ws)
+{
+    vid_t i, v;
+
+    for ( i = 0; i < ws->ntouched; i++ ) {
+        v = ws->touched[i];
+        ws->dist[v] = INFINITY;
+        ws->pred[v] = v;
+    }
+    ws->ntouched = 0;
+    lh_clear(ws->heap);
+}
+
+/**
+ * Run Dijkstra's algorithm in a workspace. The previous query is 
+ * undone first, and the search starts from the source only.
+ * @param al graph's adjacency list
+ * @param s source vertex id
+ * @param ws pointer to workspace
+ */
+void dijkstra_ws(adjlist_t *al, 
+                 vid_t s, 
+                 sssp_workspace_t *ws)
+{
+    vid_t u;
+    weight_t ukey, sum;
+    node_t *v;
+    lheap_t *heap = ws->heap;
+
+    sssp_workspace_reset(ws);
+    sssp_touch(ws, s, 0, s);
+    lh_push(heap, s, 0);
+
+    while ( !lh_empty(heap) ) {
+        u = lh_pop(heap, &ukey);
+        if ( ukey > ws->dist[u] )
+            continue;
+
+        for ( v = al->adj[u]; v != NULL; v = v->next ) {
+            sum = ukey + v->weight;
+            if ( ws->dist[v->id] > sum ) {
+                sssp_touch(ws, v->id, sum, u);
+                lh_push(heap, v->id, sum);
+            }
+        }
+    }
+}
+
+/**
+ * Run Dijkstra's algorithm in a workspace on a CSR graph
+ * @param g CSR graph
+ * @param s source vertex id
+ * @param ws pointer to workspace
+ */
+void dijkstra_ws_csr(csr_t *g, 
+                     vid_t s, 
+                     sssp_workspace_t *ws)
+{
+    vid_t u, v;
+    eid_t e, end;
+    weight_t ukey, sum;
+    lheap_t *heap = ws->heap;
+
+    sssp_workspace_reset(ws);
+    sssp_touch(ws, s, 0, s);
+    lh_push(heap, s, 0);
+
+    while ( !lh_empty(heap) ) {
+        u = lh_pop(heap, &ukey);
+        if ( ukey > ws->dist[u] )
+            continue;
+
+        end = g->offsets[u+1];
+        for ( e = g->offsets[u]; e < end; e++ ) {
+            v = g->neighbors[e];
+            sum = ukey + g->weights[e];
+            if ( ws->dist[v] > sum ) {
+                sssp_touch(ws, v, sum, u);
+                lh_push(heap, v, sum);
+            }
+        }
+    }
+}
+
+/**
+ * Run Dijkstra's algorithm from s in a workspace until t is settled
+ * @param g CSR graph
+ * @param s source vertex id
+ * @param t target vertex id
+ * @param ws pointer to workspace
+ * @return distance from s to t (INFINITY if t is unreachable)
+ */
+weight_t dijkstra_st_csr(csr_t *g, 
+                         vid_t s, 
+                         vid_t t, 
+                         sssp_workspace_t *ws)
+{
+    vid_t u, v;
+    eid_t e, end;
+    weight_t ukey, sum;
+    lheap_t *heap = ws->heap;
+
+    sssp_workspace_reset(ws);
+    sssp_touch(ws, s, 0, s);
+    lh_push(heap, s, 0);
+
+    while ( !lh_empty(heap) ) {
+        u = lh_pop(heap, &ukey);
+        if ( ukey > ws->dist[u] )
+            continue;
+        if ( u == t )
+            break;
+
+        end = g->offsets[u+1];
+        for ( e = g->offsets[u]; e < end; e++ ) {
+            v = g->neighbors[e];
+            sum = ukey + g->weights[e];
+            if ( ws->dist[v] > sum ) {
+                sssp_touch(ws, v, sum, u);
+                lh_push(heap, v, sum);
+            }
+        }
+    }
+
+    return ws->dist[t];
+}
+
+/**
+ * Settles one vertex of one direction of a bidirectional search, and 
+ * updates the best path through every vertex whose label drops
+ * @param g graph searched in this direction
+ * @param ws workspace of this direction
+ * @param other workspace of the opposite direction
+ * @param mu length of the best path found so far
+ * @param meet vertex where the best path joins both searches
+ */
+static void sssp_bidir_step(csr_t *g, 
+                            sssp_workspace_t *ws, 
+                            const sssp_workspace_t *other, 
+                            weight_t *mu, 
+                            vid_t *meet)
+{
+    vid_t u, v;
+    eid_t e, end;
+    weight_t ukey, sum;
+
+    u = lh_pop(ws->heap, &ukey);
+    if ( ukey > ws->dist[u] )
+        return;
+
+    end = g->offsets[u+1];
+    for ( e = g->offsets[u]; e < end; e++ ) {
+        v = g->neighbors[e];
+        sum = ukey + g->weights[e];
+        if ( ws->dist[v] > sum ) {
+            sssp_touch(ws, v, sum, u);
+            lh_push(ws->heap, v, sum);
+            if ( other->dist[v] < INFINITY && sum + other->dist[v] < *mu ) {
+                *mu = sum + other->dist[v];
+                *meet = v;
+            }
+        }
+    }
+}
+
+/**
+ * Bidirectional point-to-point query. Each step settles a vertex on 
+ * the side with the smaller heap.
+ * @param g CSR graph
+ * @param gr transpose of g (g itself for undirected graphs)
+ * @param s source vertex id
+ * @param t target vertex id
+ * @param fw forward workspace (results from s)
+ * @param bw backward workspace (results towards t)
+ * @param meet vertex of the shortest path settled or labelled by both 
+ *        searches (output, undefined if t is unreachable)
+ * @return distance from s to t (INFINITY if t is unreachable)
+ */
+weight_t dijkstra_bidir_csr(csr_t *g, 
+                            csr_t *gr, 
+                            vid_t s, 
+                            vid_t t, 
+                            sssp_workspace_t *fw, 
+                            sssp_workspace_t *bw, 
+                            vid_t *meet)
+{
+    weight_t mu = INFINITY;
+
+    sssp_workspace_reset(fw);
+    sssp_workspace_reset(bw);
+    sssp_touch(fw, s, 0, s);
+    lh_push(fw->heap, s, 0);
+    sssp_touch(bw, t, 0, t);
+    lh_push(bw->heap, t, 0);
+    *meet = s;
+    if ( s == t )
+        return 0;
+
+    while ( !lh_empty(fw->heap) && !lh_empty(bw->heap) ) {
+        if ( lh_top_key(fw->heap) + lh_top_key(bw->heap) >= mu )
+            break;
+        if ( fw->heap->curr_size <= bw->heap->curr_size )
+            sssp_bidir_step(g, fw, bw, &mu, meet);
+        else
+            sssp_bidir_step(gr, bw, fw, &mu, meet);
+    }
+
+    return mu;
+}
+
+/**
+ * Writes the shortest path to t found by the last query of a workspace
+ * @param ws pointer to workspace
+ * @param t target vertex id
+ * @param path path vertices from the source to t (output, room for 
+ *        ws->nvertices entries)
+ * @return number of path vertices (0 if t was not reached)
+ */
+vid_t sssp_path(const sssp_workspace_t *ws, 
+                vid_t t, 
+                vid_t *path)
+{
+    vid_t v, n = 1, i;
+
+    if ( ws->dist[t] == INFINITY )
+        return 0;
+
+    for ( v = t; ws->pred[v] != v; v = ws->pred[v] )
+        n++;
+    for ( v = t, i = n; i > 0; v = ws->pred[v] )
+        path[--i] = v;
+
+    return n;
+}
+
+/**
+ * Writes the shortest path found by the last bidirectional query: the 
+ * forward predecessors lead from meet back to the source, and the 
+ * backward ones from meet on to the target
+ * @param fw forward workspace
+ * @param bw backward workspace
+ * @param meet meeting vertex returned by dijkstra_bidir_csr()
+ * @param path path vertices from the source to the target (output, 
+ *        room for fw->nvertices entries)
+ * @return number of path vertices (0 if the target was not reached)
+ */
+vid_t sssp_bidir_path(const sssp_workspace_t *fw, 
+                      const sssp_workspace_t *bw, 
+                      vid_t meet, 
+                      vid_t *path)
+{
+    vid_t v, n;
+
+    if ( fw->dist[meet] == INFINITY || bw->dist[meet] == INFINITY )
+        return 0;
+
+    n = sssp_path(fw, meet, path);
+    for ( v = meet; bw->pred[v] != v; ) {
+        v = bw->pred[v];
+        path[n++] = v;
+    }
+
+    return n;
+}
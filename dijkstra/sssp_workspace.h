@@ -0,0 +1,95 @@
+/**
+ * @file
+ * Reusable single-source shortest path workspace.
+ *
+ * The workspace owns the distance and predecessor arrays and a 
+ * push-only heap, and keeps them across queries. Every vertex whose 
+ * distance is set during a query is recorded in a touched list, and 
+ * the next query resets only those vertices, so that the cost of a 
+ * query follows its search space rather than the graph size.
+ *
+ * Point-to-point queries stop as soon as the target is settled. The 
+ * bidirectional variant searches forward from the source in a first 
+ * workspace and backward from the target, on the transposed graph, in 
+ * a second one; it stops once the smallest keys of both heaps add up 
+ * to at least the best path found so far.
+ */ 
+
+#ifndef SSSP_WORKSPACE_H_
+#define SSSP_WORKSPACE_H_
+
+#include "binary_heap/lazy_heap.h"
+#include "graph/adjlist.h"
+#include "graph/csr.h"
+#include "graph/graph.h"
+
+/**
+ * Workspace data structure. After a query, dist and pred hold its 
+ * results for every vertex (INFINITY and the vertex itself for 
+ * vertices that were not reached), until the next query.
+ */ 
+typedef struct sssp_workspace_st {
+    vid_t nvertices; //!< number of graph vertices
+    weight_t *dist; //!< distance array
+    vid_t *pred; //!< predecessor array
+    vid_t *touched; //!< vertices with a finite distance
+    vid_t ntouched; //!< number of touched vertices
+    lheap_t *heap; //!< push-only heap, emptied after each query
+} sssp_workspace_t;
+
+/**
+ * Sets the distance and predecessor of a vertex, recording it as 
+ * touched the first time. A vertex is its own predecessor until it is 
+ * touched, and afterwards only if it is the source, which is touched 
+ * first and never again.
+ * @param ws pointer to workspace
+ * @param v vertex id
+ * @param d new distance
+ * @param p new predecessor
+ */ 
+static inline void sssp_touch(sssp_workspace_t *ws, 
+                              vid_t v, 
+                              weight_t d, 
+                              vid_t p)
+{
+    if ( ws->pred[v] == v )
+        ws->touched[ws->ntouched++] = v;
+    ws->dist[v] = d;
+    ws->pred[v] = p;
+}
+
+extern sssp_workspace_t* sssp_workspace_create(vid_t nvertices);
+extern void sssp_workspace_destroy(sssp_workspace_t *ws);
+extern void sssp_workspace_reset(sssp_workspace_t *ws);
+
+extern void dijkstra_ws(adjlist_t *al, 
+                        vid_t s, 
+                        sssp_workspace_t *ws);
+
+extern void dijkstra_ws_csr(csr_t *g, 
+                            vid_t s, 
+                            sssp_workspace_t *ws);
+
+extern weight_t dijkstra_st_csr(csr_t *g, 
+                                vid_t s, 
+                                vid_t t, 
+                                sssp_workspace_t *ws);
+
+extern weight_t dijkstra_bidir_csr(csr_t *g, 
+                                   csr_t *gr, 
+                                   vid_t s, 
+                                   vid_t t, 
+                                   sssp_workspace_t *fw, 
+                                   sssp_workspace_t *bw, 
+                                   vid_t *meet);
+
+extern vid_t sssp_path(const sssp_workspace_t *ws, 
+                       vid_t t, 
+                       vid_t *path);
+
+extern vid_t sssp_bidir_path(const sssp_workspace_t *fw, 
+                             const sssp_workspace_t *bw, 
+                             vid_t meet, 
+                             vid_t *path);
+
+#endif
@@ -0,0 +1,167 @@
+/**
+ * @file
+ * Checks Contraction Hierarchies queries and unpacked paths against
+ * point-to-point Dijkstra over random (source, target) pairs, checks
+ * the hierarchy file round trip, and times preprocessing and queries
+ */
+
+#include "ch.h"
+#include "sssp_workspace.h"
+#include "graph/adjlist.h"
+#include "graph/csr.h"
+#include "graph/dimacs.h"
+#include "graph/generators.h"
+#include "graph/graph.h"
+#include "util/tsc_x86_64.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * Checks that a path goes from s to t along graph edges, with the
+ * given length
+ */
+static void check_path(csr_t *g,
+                       const vid_t *path,
+                       vid_t n,
+                       vid_t s,
+                       vid_t t,
+                       weight_t len)
+{
+    vid_t i;
+    eid_t e;
+    weight_t sum = 0;
+
+    assert(n > 0 && path[0] == s && path[n-1] == t);
+    for ( i = 0; i + 1 < n; i++ ) {
+        for ( e = g->offsets[path[i]]; g->neighbors[e] != path[i+1]; e++ )
+            assert(e + 1 < g->offsets[path[i]+1]);
+        sum += g->weights[e];
+    }
+    assert(fabs(sum - len) <= 1e-4 * len);
+}
+
+/**
+ * Checks that two edge sets are identical
+ */
+static void check_edges(const ch_edges_t *a, const ch_edges_t *b, vid_t n)
+{
+    assert(a->nedges == b->nedges);
+    assert(memcmp(a->offsets, b->offsets, (n + 1) * sizeof(eid_t)) == 0);
+    assert(memcmp(a->ids, b->ids, a->nedges * sizeof(vid_t)) == 0);
+    assert(memcmp(a->weights, b->weights,
+                  a->nedges * sizeof(weight_t)) == 0);
+    assert(memcmp(a->mids, b->mids, a->nedges * sizeof(vid_t)) == 0);
+}
+
+int main(int argc, char **argv)
+{
+    csr_t *g;
+    adjlist_stats_t stats;
+    dimacs_t *d;
+    int is_undirected, q, nqueries, nthreads;
+    vid_t s, t, n, meet, *path;
+    weight_t d_ref, d_ch;
+    sssp_workspace_t *ws, *fw, *bw;
+    ch_t *ch, *ch_file;
+    char chfile[] = "/tmp/test_ch.XXXXXX";
+    tsctimer_t t_build, t_dijkstra, t_ch;
+    double hz;
+
+    if ( argc < 2 ) {
+        printf("Usage: ./test_ch <graphfile|generator spec> [nqueries] "
+               "[hierarchy file] [nthreads]\n");
+        exit(EXIT_FAILURE);
+    }
+    nqueries = argc > 2 ? atoi(argv[2]) : 100;
+    nthreads = argc > 4 ? atoi(argv[4]) : 0;
+
+    adjlist_init_stats(&stats);
+    if ( gen_is_spec(argv[1]) ) {
+        d = gen_from_spec(argv[1], &is_undirected, 0);
+        g = csr_build(d->nvertices, d->narcs, d->src, d->dst, d->weight,
+                      &stats, is_undirected, 0);
+        dimacs_destroy(d);
+    } else {
+        g = csr_read(argv[1], &stats, 0);
+    }
+
+    // Hierarchy: mapped from the given file if it holds one, otherwise
+    // built (and saved to the file, if any)
+    timer_clear(&t_build);
+    if ( argc > 3 && ch_is_file(argv[3]) ) {
+        ch = ch_mmap(argv[3]);
+        assert(ch->nvertices == g->nvertices);
+    } else {
+        timer_start(&t_build);
+        ch = ch_build(g, nthreads);
+        timer_stop(&t_build);
+        if ( argc > 3 ) {
+            ch_write(ch, argv[3]);
+        } else {
+            // Save/map round trip
+            close(mkstemp(chfile));
+            ch_write(ch, chfile);
+            assert(ch_is_file(chfile));
+            ch_file = ch_mmap(chfile);
+            assert(ch_file->nvertices == ch->nvertices);
+            assert(memcmp(ch_file->rank, ch->rank,
+                          ch->nvertices * sizeof(vid_t)) == 0);
+            check_edges(&ch_file->up, &ch->up, ch->nvertices);
+            check_edges(&ch_file->down, &ch->down, ch->nvertices);
+            ch_destroy(ch);
+            ch = ch_file;
+            unlink(chfile);
+        }
+    }
+    fprintf(stdout, "%" PRIeid " edges, %" PRIeid " upward and %" PRIeid
+                    " downward hierarchy edges\n",
+            g->nedges, ch->up.nedges, ch->down.nedges);
+
+    ws = sssp_workspace_create(g->nvertices);
+    fw = sssp_workspace_create(g->nvertices);
+    bw = sssp_workspace_create(g->nvertices);
+    path = (vid_t*)malloc(g->nvertices * sizeof(vid_t));
+    timer_clear(&t_dijkstra);
+    timer_clear(&t_ch);
+
+    srand(1);
+    for ( q = 0; q < nqueries; q++ ) {
+        s = rand() % g->nvertices;
+        t = rand() % g->nvertices;
+
+        timer_start(&t_dijkstra);
+        d_ref = dijkstra_st_csr(g, s, t, ws);
+        timer_stop(&t_dijkstra);
+
+        timer_start(&t_ch);
+        d_ch = ch_query(ch, s, t, fw, bw, &meet);
+        timer_stop(&t_ch);
+
+        // Shortcut weights sum the same edges in another order
+        assert(d_ch == d_ref || fabs(d_ch - d_ref) <= 1e-4 * d_ref);
+        n = ch_path(ch, fw, bw, meet, path);
+        assert(n > 0 || isinf(d_ref));
+        if ( n > 0 )
+            check_path(g, path, n, s, t, d_ch);
+    }
+
+    hz = timer_read_hz();
+    fprintf(stdout, "preprocessing %lf s, %d queries: dijkstra s-t %lf s, "
+                    "CH %lf s\n",
+            timer_total(&t_build) / hz, nqueries,
+            timer_total(&t_dijkstra) / hz, timer_total(&t_ch) / hz);
+
+    free(path);
+    sssp_workspace_destroy(bw);
+    sssp_workspace_destroy(fw);
+    sssp_workspace_destroy(ws);
+    ch_destroy(ch);
+    csr_destroy(g);
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file
+ * Checks delta-stepping against dijkstra_csr() over random sources,
+ * bucket widths and thread counts, and times both
+ */
+
+#include "delta_stepping.h"
+#include "dijkstra.h"
+#include "graph/adjlist.h"
+#include "graph/csr.h"
+#include "graph/dimacs.h"
+#include "graph/generators.h"
+#include "graph/graph.h"
+#include "util/tsc_x86_64.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Checks that the predecessors form a shortest path tree rooted at s:
+ * each reached vertex hangs from an edge that gives it its distance,
+ * and following predecessors always leads back to s
+ */
+static void check_tree(csr_t *g,
+                       vid_t s,
+                       const vid_t *pred,
+                       const weight_t *dist)
+{
+    vid_t v, u, w, *depth = (vid_t*)malloc(g->nvertices * sizeof(vid_t));
+    eid_t e;
+
+    assert(pred[s] == s && dist[s] == 0);
+    for ( v = 0; v < g->nvertices; v++ ) {
+        depth[v] = VID_MAX;
+        if ( v == s )
+            continue;
+        if ( isinf(dist[v]) ) {
+            assert(pred[v] == v);
+            continue;
+        }
+        u = pred[v];
+        for ( e = g->offsets[u]; g->neighbors[e] != v; e++ )
+            assert(e + 1 < g->offsets[u+1]);
+        assert(dist[u] + g->weights[e] == dist[v]);
+    }
+
+    // Depths, marking the chain being walked with nvertices
+    depth[s] = 0;
+    for ( v = 0; v < g->nvertices; v++ ) {
+        if ( isinf(dist[v]) )
+            continue;
+        for ( u = v; depth[u] == VID_MAX; u = pred[u] )
+            depth[u] = g->nvertices;
+        assert(depth[u] != g->nvertices);
+        for ( w = v; depth[w] == g->nvertices; w = pred[w] )
+            depth[w] = 1;
+    }
+
+    free(depth);
+}
+
+int main(int argc, char **argv)
+{
+    csr_t *g;
+    adjlist_stats_t stats;
+    dimacs_t *d;
+    int is_undirected, q, k, nsources, nthreads;
+    vid_t s, *pred, *ds_pred, *ds_pred_mt;
+    weight_t *dist, *ds_dist, *ds_dist_mt, delta;
+    dijkstra_pq_t *heap;
+    tsctimer_t t_dijkstra, t_delta, t_delta_mt;
+    double hz;
+
+    if ( argc < 2 ) {
+        printf("Usage: ./test_delta <graphfile|generator spec> [nsources] "
+               "[nthreads]\n");
+        exit(EXIT_FAILURE);
+    }
+    nsources = argc > 2 ? atoi(argv[2]) : 4;
+    nthreads = argc > 3 ? atoi(argv[3]) : 4;
+
+    adjlist_init_stats(&stats);
+    if ( gen_is_spec(argv[1]) ) {
+        d = gen_from_spec(argv[1], &is_undirected, 0);
+        g = csr_build(d->nvertices, d->narcs, d->src, d->dst, d->weight,
+                      &stats, is_undirected, 0);
+        dimacs_destroy(d);
+    } else {
+        g = csr_read(argv[1], &stats, 0);
+    }
+    delta = delta_stepping_delta(&stats);
+    fprintf(stdout, "Maximum edge weight: %f, delta: %f\n",
+            stats.max_edge_weight, delta);
+
+    dijkstra_alloc_arrays_csr(g, &pred, &dist);
+    dijkstra_alloc_arrays_csr(g, &ds_pred, &ds_dist);
+    dijkstra_alloc_arrays_csr(g, &ds_pred_mt, &ds_dist_mt);
+    timer_clear(&t_dijkstra);
+    timer_clear(&t_delta);
+    timer_clear(&t_delta_mt);
+
+    srand(1);
+    for ( q = 0; q < nsources; q++ ) {
+        s = rand() % g->nvertices;
+
+        heap = dijkstra_init_csr(g, s, pred, dist);
+        timer_start(&t_dijkstra);
+        dijkstra_csr(g, s, heap, pred, dist);
+        timer_stop(&t_dijkstra);
+        dijkstra_finalize(NULL, NULL, heap);
+
+        timer_start(&t_delta);
+        delta_stepping_csr(g, s, delta, ds_pred, ds_dist, 1);
+        timer_stop(&t_delta);
+        timer_start(&t_delta_mt);
+        delta_stepping_csr(g, s, delta, ds_pred_mt, ds_dist_mt, nthreads);
+        timer_stop(&t_delta_mt);
+
+        // Distances are bit-identical, predecessors do not depend on
+        // the number of threads
+        assert(memcmp(dist, ds_dist, g->nvertices * sizeof(weight_t)) == 0);
+        assert(memcmp(dist, ds_dist_mt,
+                      g->nvertices * sizeof(weight_t)) == 0);
+        assert(memcmp(ds_pred, ds_pred_mt,
+                      g->nvertices * sizeof(vid_t)) == 0);
+        check_tree(g, s, ds_pred_mt, ds_dist_mt);
+
+        // Narrow and wide buckets (mostly heavy and all light edges)
+        for ( k = 0; k < 2; k++ ) {
+            delta_stepping_csr(g, s, k ? 8 * delta : delta / 8,
+                               ds_pred_mt, ds_dist_mt, nthreads);
+            assert(memcmp(dist, ds_dist_mt,
+                          g->nvertices * sizeof(weight_t)) == 0);
+            assert(memcmp(ds_pred, ds_pred_mt,
+                          g->nvertices * sizeof(vid_t)) == 0);
+        }
+    }
+
+    hz = timer_read_hz();
+    fprintf(stdout, "%d sources, seconds per source: dijkstra %lf, "
+                    "delta-stepping %lf (1 thread), %lf (%d threads)\n",
+            nsources,
+            timer_total(&t_dijkstra) / hz / nsources,
+            timer_total(&t_delta) / hz / nsources,
+            timer_total(&t_delta_mt) / hz / nsources, nthreads);
+
+    dijkstra_finalize(pred, dist, NULL);
+    dijkstra_finalize(ds_pred, ds_dist, NULL);
+    dijkstra_finalize(ds_pred_mt, ds_dist_mt, NULL);
+    csr_destroy(g);
+
+    return 0;
+}
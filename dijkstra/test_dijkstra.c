@@ -9,40 +9,82 @@
 #include <stdlib.h>
 #include <unistd.h>
 
+#include "delta_stepping.h"
 #include "dijkstra.h"
 #include "graph/adjlist.h"
+#include "graph/csr.h"
+#include "graph/csr_file.h"
+#include "graph/dimacs.h"
+#include "graph/dyngraph.h"
+#include "graph/generators.h"
 #include "graph/graph.h"
+#include "graph/reorder.h"
 #include "util/tsc_x86_64.h"
 
 int main(int argc, char **argv)
 {
-    adjlist_t *al;
+    adjlist_t *al = NULL;
+    csr_t *g = NULL;
+    ccsr_t *cg = NULL;
+    dyngraph_t *dg = NULL;
     adjlist_stats_t stats;
-    bheap_t *heap;
-    weight_t *dist;
-    unsigned int i, *pred, source = 0, is_undirected;
-    int next_option, print_flag, test_flag;
+    dijkstra_pq_t *heap;
+    weight_t *dist, delta = 0;
+    vid_t i, *pred, source = 0, nvertices;
+    unsigned int is_undirected;
+    int gen_undirected;
+    dimacs_t *d;
+    reorder_method_t reorder_method = REORDER_NONE;
+    reorder_t *r = NULL;
+    int next_option, print_flag, test_flag, csr_flag, compressed_flag;
+    int dynamic_flag, radix_flag, lazy_flag, delta_flag, dial_flag, nthreads;
     char graphfile[256];
 
     if ( argc == 1 ) {
-        printf("Usage: ./dijkstra --graph <graphfile>\n"
+        printf("Usage: ./dijkstra --graph <graphfile|generator spec>\n"
                "\t\t --nthreads <nthreads>\n" 
                "\t\t --source <source>\n" 
                "\t\t --test\n" 
+               "\t\t --csr (implied for binary snapshots)\n" 
+               "\t\t --reorder <none|rcm|degree|bfs> (implies --csr)\n" 
+               "\t\t --compressed (implies --csr)\n" 
+               "\t\t --dynamic (implies --csr)\n" 
+               "\t\t --radix (radix heap; adjacency list or CSR only)\n" 
+               "\t\t --lazy (push-only heap; adjacency list or CSR only)\n" 
+               "\t\t --delta (parallel delta-stepping; implies --csr)\n" 
+               "\t\t --dial (bucket queue for small integer weights; "
+               "adjacency list or CSR only)\n" 
                "\t\t --print\n");
         exit(EXIT_FAILURE);
     }
 
     print_flag=0;
     test_flag=0;
+    csr_flag=0;
+    compressed_flag=0;
+    dynamic_flag=0;
+    radix_flag=0;
+    lazy_flag=0;
+    delta_flag=0;
+    dial_flag=0;
+    nthreads=0;
 
     /* getopt stuff */
-    const char* short_options = "g:n:l:c:s:pt";
+    const char* short_options = "g:n:l:c:s:r:ptCZDRLSB";
     const struct option long_options[]={
         {"graph", 1, NULL, 'g'},
         {"source", 1, NULL, 's'},
         {"print", 0, NULL, 'p'},
         {"test", 0, NULL, 't'},
+        {"csr", 0, NULL, 'C'},
+        {"reorder", 1, NULL, 'r'},
+        {"compressed", 0, NULL, 'Z'},
+        {"dynamic", 0, NULL, 'D'},
+        {"radix", 0, NULL, 'R'},
+        {"lazy", 0, NULL, 'L'},
+        {"delta", 0, NULL, 'S'},
+        {"dial", 0, NULL, 'B'},
+        {"nthreads", 1, NULL, 'n'},
         {NULL, 0, NULL, 0}
     };
 
@@ -58,6 +100,47 @@ int main(int argc, char **argv)
                 print_flag = 1;
                 break;
 
+            case 'C':
+                csr_flag = 1;
+                break;
+
+            case 'Z':
+                csr_flag = 1;
+                compressed_flag = 1;
+                break;
+
+            case 'D':
+                csr_flag = 1;
+                dynamic_flag = 1;
+                break;
+
+            case 'R':
+                radix_flag = 1;
+                break;
+
+            case 'L':
+                lazy_flag = 1;
+                break;
+
+            case 'S':
+                csr_flag = 1;
+                delta_flag = 1;
+                break;
+
+            case 'B':
+                dial_flag = 1;
+                break;
+
+            case 'n':
+                nthreads = atoi(optarg);
+                break;
+
+            case 'r':
+                reorder_method = reorder_parse(optarg);
+                if ( reorder_method != REORDER_NONE )
+                    csr_flag = 1;
+                break;
+
             case 's':
                 source = atoi(optarg);
                 break;
@@ -79,23 +162,143 @@ int main(int argc, char **argv)
 
     } while(next_option != -1);
 
-    // Init adjacency list
+    // Init adjacency list (or CSR graph)
     adjlist_init_stats(&stats);
     is_undirected = 0;
-    al = adjlist_read(graphfile, &stats, is_undirected);
+    if ( csr_is_binary(graphfile) ) {
+        csr_flag = 1;
+        g = csr_mmap(graphfile);
+        nvertices = g->nvertices;
+    } else if ( gen_is_spec(graphfile) ) {
+        // Synthetic graph, built in memory
+        d = gen_from_spec(graphfile, &gen_undirected, 0);
+        if ( csr_flag )
+            g = csr_build(d->nvertices, d->narcs, d->src, d->dst, d->weight,
+                          &stats, is_undirected || gen_undirected, 0);
+        else
+            al = adjlist_build(d->nvertices, d->narcs, d->src, d->dst, 
+                               d->weight, &stats, 
+                               is_undirected || gen_undirected, 0);
+        nvertices = d->nvertices;
+        dimacs_destroy(d);
+    } else if ( csr_flag ) {
+        g = csr_read(graphfile, &stats, is_undirected);
+        nvertices = g->nvertices;
+    } else {
+        al = adjlist_read(graphfile, &stats, is_undirected);
+        nvertices = al->nvertices;
+    }
     fprintf(stdout, "Read graph\n\n");
 
+    // Relabel vertices for locality; the source is given, and results 
+    // are printed, in original ids
+    if ( reorder_method != REORDER_NONE ) {
+        csr_t *h;
+        r = reorder_compute(g, reorder_method);
+        h = csr_permute(g, r);
+        csr_destroy(g);
+        g = h;
+        source = r->perm[source];
+    }
+
+    if ( compressed_flag ) {
+        cg = csr_to_ccsr(g, 0);
+        csr_destroy(g);
+        fprintf(stdout, "Compressed graph: %zu bytes (%.2f bytes/edge)\n\n",
+                ccsr_bytes(cg), 
+                cg->nedges ? (double)ccsr_bytes(cg) / cg->nedges : 0.0);
+    }
+
+    if ( dynamic_flag && !cg ) {
+        dg = csr_to_dyngraph(g, 0);
+        csr_destroy(g);
+        fprintf(stdout, "Dynamic graph: %" PRIeid " edges\n\n", dg->nedges);
+    }
+
     /*adjlist_print(al);*/
 
-    // Init Dijkstra structures
-    dijkstra_alloc_arrays(al, &pred, &dist);
-    heap = dijkstra_init(al, source, pred, dist);
+    if ( (radix_flag || lazy_flag || dial_flag) && (dg || cg) ) {
+        fprintf(stderr, "--radix, --lazy and --dial need an adjacency list "
+                        "or CSR graph\n");
+        exit(EXIT_FAILURE);
+    }
+    if ( delta_flag && (dg || cg) ) {
+        fprintf(stderr, "--delta needs a CSR graph\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Bucket width and Dial's bucket span from the weights seen while 
+    // reading (a mapped snapshot has no statistics, so they are 
+    // gathered here)
+    if ( (delta_flag || dial_flag) && csr_flag && stats.nvertices == 0 ) {
+        eid_t e;
+        stats.nvertices = g->nvertices;
+        stats.nedges = g->nedges;
+        for ( e = 0; e < g->nedges; e++ )
+            if ( g->weights[e] > stats.max_edge_weight )
+                stats.max_edge_weight = g->weights[e];
+    }
+    if ( delta_flag ) {
+        delta = delta_stepping_delta(&stats);
+        fprintf(stdout, "Delta: %f\n\n", delta);
+    }
+
+    if ( dial_flag && !(csr_flag ? dijkstra_dial_applicable_csr(g, &stats)
+                                 : dijkstra_dial_applicable(al, &stats)) ) {
+        fprintf(stdout, "Weights are not integers up to %d, "
+                        "using the heap\n\n", DIJKSTRA_DIAL_MAX_WEIGHT);
+        dial_flag = 0;
+    }
+
+    // Init Dijkstra structures (the radix, push-only heap, Dial and 
+    // delta-stepping variants need none)
+    heap = NULL;
+    if ( (radix_flag || lazy_flag || dial_flag || delta_flag) && csr_flag ) {
+        dijkstra_alloc_arrays_csr(g, &pred, &dist);
+    } else if ( radix_flag || lazy_flag || dial_flag ) {
+        dijkstra_alloc_arrays(al, &pred, &dist);
+    } else if ( dg ) {
+        dijkstra_alloc_arrays_dyn(dg, &pred, &dist);
+        heap = dijkstra_init_dyn(dg, source, pred, dist);
+    } else if ( cg ) {
+        dijkstra_alloc_arrays_ccsr(cg, &pred, &dist);
+        heap = dijkstra_init_ccsr(cg, source, pred, dist);
+    } else if ( csr_flag ) {
+        dijkstra_alloc_arrays_csr(g, &pred, &dist);
+        heap = dijkstra_init_csr(g, source, pred, dist);
+    } else {
+        dijkstra_alloc_arrays(al, &pred, &dist);
+        heap = dijkstra_init(al, source, pred, dist);
+    }
 
     tsctimer_t tim;
     timer_clear(&tim);
     timer_start(&tim);
     
-    dijkstra(al, source, heap, pred, dist);
+    if ( delta_flag )
+        delta_stepping_csr(g, source, delta, pred, dist, nthreads);
+    else if ( dial_flag && csr_flag )
+        dijkstra_dial_csr(g, source, (unsigned int)stats.max_edge_weight, 
+                          pred, dist);
+    else if ( dial_flag )
+        dijkstra_dial(al, source, (unsigned int)stats.max_edge_weight, 
+                      pred, dist);
+    else if ( lazy_flag && csr_flag )
+        dijkstra_lazy_csr(g, source, pred, dist);
+    else if ( lazy_flag )
+        dijkstra_lazy(al, source, pred, dist);
+    else if ( radix_flag && csr_flag )
+        dijkstra_radix_csr(g, source, pred, dist);
+    else if ( radix_flag )
+        dijkstra_radix(al, source, pred, dist);
+    else if ( dg )
+        dijkstra_dyn(dg, source, heap, pred, dist);
+    else if ( cg )
+        dijkstra_ccsr(cg, source, heap, pred, dist);
+    else if ( csr_flag )
+        dijkstra_csr(g, source, heap, pred, dist);
+    else
+        dijkstra(al, source, heap, pred, dist);
     
     timer_stop(&tim);
     double hz = timer_read_hz();
@@ -104,12 +307,25 @@ int main(int argc, char **argv)
                     timer_total(&tim) / hz,
                     hz );
 
-    if ( print_flag )
-        for ( i = 0; i < al->nvertices; i++ )
-            printf("pred[%d] = %d\n", i, pred[i]); 
+    if ( print_flag && r )
+        for ( i = 0; i < nvertices; i++ )
+            printf("pred[%" PRIvid "] = %" PRIvid "\n", 
+                   i, r->inv[pred[r->perm[i]]]); 
+    else if ( print_flag )
+        for ( i = 0; i < nvertices; i++ )
+            printf("pred[%" PRIvid "] = %" PRIvid "\n", i, pred[i]); 
 
     dijkstra_finalize(pred, dist, heap);
-    adjlist_destroy(al);
+    if ( r )
+        reorder_destroy(r);
+    if ( dg )
+        dyngraph_destroy(dg);
+    else if ( cg )
+        ccsr_destroy(cg);
+    else if ( csr_flag )
+        csr_destroy(g);
+    else
+        adjlist_destroy(al);
 
     return 0;
 }
@@ -0,0 +1,223 @@
+/**
+ * @file
+ * Checks workspace shortest path queries, full and point-to-point 
+ * (plain, bidirectional and ALT), against dijkstra_csr(), and times 
+ * them over random (source, target) pairs. Also checks and times a 
+ * batch of full queries over a thread pool.
+ */ 
+
+#include "alt.h"
+#include "dijkstra.h"
+#include "sssp_batch.h"
+#include "sssp_workspace.h"
+#include "graph/adjlist.h"
+#include "graph/csr.h"
+#include "graph/dimacs.h"
+#include "graph/generators.h"
+#include "graph/graph.h"
+#include "util/tsc_x86_64.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * Default number of landmarks
+ */
+#define NLANDMARKS 8
+
+/**
+ * Checks that a path goes from s to t along graph edges, with the 
+ * given length
+ */
+static void check_path(csr_t *g, 
+                       const vid_t *path, 
+                       vid_t n, 
+                       vid_t s, 
+                       vid_t t, 
+                       weight_t len)
+{
+    vid_t i;
+    eid_t e;
+    weight_t sum = 0;
+
+    assert(n > 0 && path[0] == s && path[n-1] == t);
+    for ( i = 0; i + 1 < n; i++ ) {
+        for ( e = g->offsets[path[i]]; g->neighbors[e] != path[i+1]; e++ )
+            assert(e + 1 < g->offsets[path[i]+1]);
+        sum += g->weights[e];
+    }
+    assert(fabs(sum - len) <= 1e-4 * len);
+}
+
+int main(int argc, char **argv)
+{
+    csr_t *g, *gr;
+    adjlist_stats_t stats;
+    dimacs_t *d;
+    int is_undirected, q, nqueries;
+    size_t j;
+    vid_t i, s, t, n, meet, *pred, *sources, *targets, *path;
+    weight_t *dist, d_st, *matrix;
+    dijkstra_pq_t *heap;
+    sssp_workspace_t *ws, *bw;
+    alt_t *alt, *alt_file;
+    char altfile[] = "/tmp/test_sssp.XXXXXX";
+    tsctimer_t t_full, t_ws, t_st, t_bidir, t_alt, t_batch;
+    double hz;
+
+    if ( argc < 2 ) {
+        printf("Usage: ./test_sssp <graphfile|generator spec> [nqueries] "
+               "[landmark file] [nthreads]\n");
+        exit(EXIT_FAILURE);
+    }
+    nqueries = argc > 2 ? atoi(argv[2]) : 10;
+
+    adjlist_init_stats(&stats);
+    if ( gen_is_spec(argv[1]) ) {
+        d = gen_from_spec(argv[1], &is_undirected, 0);
+        g = csr_build(d->nvertices, d->narcs, d->src, d->dst, d->weight,
+                      &stats, is_undirected, 0);
+        dimacs_destroy(d);
+    } else {
+        g = csr_read(argv[1], &stats, 0);
+    }
+
+    gr = csr_transpose(g);
+
+    // Landmarks: mapped from the given file if it holds them, otherwise 
+    // computed (and saved to the file, if any)
+    if ( argc > 3 && alt_is_file(argv[3]) ) {
+        alt = alt_mmap(argv[3], g->nvertices);
+    } else {
+        alt = alt_build(g, gr, NLANDMARKS);
+        if ( argc > 3 ) {
+            alt_write(alt, argv[3]);
+        } else {
+            // Save/map round trip
+            close(mkstemp(altfile));
+            alt_write(alt, altfile);
+            assert(alt_is_file(altfile));
+            alt_file = alt_mmap(altfile, g->nvertices);
+            assert(alt_file->nlandmarks == alt->nlandmarks);
+            for ( i = 0; i < alt->nlandmarks; i++ )
+                assert(alt_file->landmarks[i] == alt->landmarks[i]);
+            for ( j = 0; j < (size_t)g->nvertices * alt->nlandmarks; j++ ) {
+                assert(memcmp(&alt_file->from[j], &alt->from[j], 
+                              sizeof(weight_t)) == 0);
+                assert(memcmp(&alt_file->to[j], &alt->to[j], 
+                              sizeof(weight_t)) == 0);
+            }
+            alt_destroy(alt_file);
+            unlink(altfile);
+        }
+    }
+
+    sources = (vid_t*)malloc(nqueries * sizeof(vid_t));
+    targets = (vid_t*)malloc(nqueries * sizeof(vid_t));
+    path = (vid_t*)malloc(g->nvertices * sizeof(vid_t));
+    srand(1);
+    for ( q = 0; q < nqueries; q++ ) {
+        sources[q] = rand() % g->nvertices;
+        targets[q] = rand() % g->nvertices;
+    }
+
+    ws = sssp_workspace_create(g->nvertices);
+    bw = sssp_workspace_create(g->nvertices);
+    timer_clear(&t_full);
+    timer_clear(&t_ws);
+    timer_clear(&t_st);
+    timer_clear(&t_bidir);
+    timer_clear(&t_alt);
+
+    for ( q = 0; q < nqueries; q++ ) {
+        s = sources[q];
+
+        timer_start(&t_ws);
+        dijkstra_ws_csr(g, s, ws);
+        timer_stop(&t_ws);
+
+        // Per-query allocation and O(n) initialization
+        timer_start(&t_full);
+        dijkstra_alloc_arrays_csr(g, &pred, &dist);
+        heap = dijkstra_init_csr(g, s, pred, dist);
+        dijkstra_csr(g, s, heap, pred, dist);
+        timer_stop(&t_full);
+
+        for ( i = 0; i < g->nvertices; i++ )
+            assert(ws->dist[i] == dist[i]);
+        assert(ws->pred[s] == s);
+
+        // Point-to-point queries
+        t = targets[q];
+        timer_start(&t_st);
+        d_st = dijkstra_st_csr(g, s, t, ws);
+        timer_stop(&t_st);
+        assert(d_st == dist[t]);
+        n = sssp_path(ws, t, path);
+        assert(n > 0 || isinf(dist[t]));
+        if ( n > 0 )
+            check_path(g, path, n, s, t, d_st);
+
+        timer_start(&t_bidir);
+        d_st = dijkstra_bidir_csr(g, gr, s, t, ws, bw, &meet);
+        timer_stop(&t_bidir);
+        assert(d_st == dist[t] || fabs(d_st - dist[t]) <= 1e-4 * dist[t]);
+        n = sssp_bidir_path(ws, bw, meet, path);
+        assert(n > 0 || isinf(dist[t]));
+        if ( n > 0 )
+            check_path(g, path, n, s, t, d_st);
+
+        timer_start(&t_alt);
+        d_st = alt_query_csr(g, alt, s, t, ws);
+        timer_stop(&t_alt);
+        assert(d_st == dist[t] || fabs(d_st - dist[t]) <= 1e-4 * dist[t]);
+        n = sssp_path(ws, t, path);
+        assert(n > 0 || isinf(dist[t]));
+        if ( n > 0 )
+            check_path(g, path, n, s, t, d_st);
+
+        timer_start(&t_full);
+        dijkstra_finalize(pred, dist, heap);
+        timer_stop(&t_full);
+    }
+
+    alt_destroy(alt);
+
+    // Same sources as a batch, with a distance matrix
+    matrix = (weight_t*)malloc((size_t)nqueries * g->nvertices * 
+                               sizeof(weight_t));
+    timer_clear(&t_batch);
+    timer_start(&t_batch);
+    sssp_batch_csr(g, sources, nqueries, sssp_batch_store_dist, matrix, 
+                   argc > 4 ? atoi(argv[4]) : 4);
+    timer_stop(&t_batch);
+    for ( q = 0; q < nqueries; q++ ) {
+        dijkstra_ws_csr(g, sources[q], ws);
+        assert(memcmp(ws->dist, matrix + (size_t)q * g->nvertices, 
+                      g->nvertices * sizeof(weight_t)) == 0);
+    }
+    free(matrix);
+
+    hz = timer_read_hz();
+    fprintf(stdout, "%d queries: full init %lf s, workspace %lf s, "
+                    "s-t %lf s, bidirectional s-t %lf s, ALT s-t %lf s\n",
+            nqueries, timer_total(&t_full) / hz, timer_total(&t_ws) / hz,
+            timer_total(&t_st) / hz, timer_total(&t_bidir) / hz,
+            timer_total(&t_alt) / hz);
+    fprintf(stdout, "%d queries in a batch: %lf s\n", 
+            nqueries, timer_total(&t_batch) / hz);
+
+    sssp_workspace_destroy(bw);
+    sssp_workspace_destroy(ws);
+    free(path);
+    free(targets);
+    free(sources);
+    csr_destroy(gr);
+    csr_destroy(g);
+
+    return 0;
+}
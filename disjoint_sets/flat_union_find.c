@@ -0,0 +1,59 @@
+/**
+ * @file
+ * Flat disjoint sets function definitions
+ */ 
+
+#include "flat_union_find.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Creates n singleton sets
+ * @param n number of elements
+ * @return pointer to the disjoint sets
+ */
+uf_t* uf_create(vid_t n)
+{
+    uf_t *uf = (uf_t*)malloc(sizeof(uf_t));
+    if ( !uf ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+
+    uf->n = n;
+    uf->parent = (vid_t*)malloc((n ? n : 1) * sizeof(vid_t));
+    uf->rank = (uint8_t*)malloc(n ? n : 1);
+    if ( !uf->parent || !uf->rank ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+    uf_reset(uf);
+
+    return uf;
+}
+
+/**
+ * Deallocates disjoint sets
+ * @param uf pointer to the disjoint sets
+ */ 
+void uf_destroy(uf_t *uf)
+{
+    free(uf->parent);
+    free(uf->rank);
+    free(uf);
+}
+
+/**
+ * Makes every element a singleton set again
+ * @param uf pointer to the disjoint sets
+ */ 
+void uf_reset(uf_t *uf)
+{
+    vid_t i;
+
+    for ( i = 0; i < uf->n; i++ )
+        uf->parent[i] = i;
+    memset(uf->rank, 0, uf->n);
+}
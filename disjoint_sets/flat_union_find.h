@@ -0,0 +1,188 @@
+/**
+ * @file
+ * Flat disjoint sets type definitions and function declarations.
+ *
+ * The elements are the integers 0..n-1, and the forest is two flat 
+ * arrays indexed by element: parents (a root is its own parent) and 
+ * ranks, one byte each since a rank never exceeds log2(n). Finds halve 
+ * the path, pointing every other node on it to its grandparent in a 
+ * single pass. Compared to one malloc'd forest_node_t per element 
+ * (union_find.h), an element takes 5 bytes instead of about 40, and 
+ * parents of nearby ids share cache lines.
+ *
+ * The *_atomic functions may run in any number of threads at once. A 
+ * union links one root below the other with a compare-and-swap on its
+ * parent, retrying from the new roots if another thread linked it 
+ * first. Roots are linked in a fixed random order of their ids, so 
+ * parent pointers always go up in that order and never form a cycle, 
+ * and trees stay logarithmic in expectation without ranks. Finds split
+ * the path, pointing each node to its grandparent with a CAS that 
+ * fails harmlessly if the parent moved meanwhile; they never wait.
+ */ 
+
+#ifndef FLAT_UNION_FIND_H_
+#define FLAT_UNION_FIND_H_
+
+#include <stdint.h>
+
+#include "graph/graph.h"
+
+/**
+ * Disjoint sets of the integers 0..n-1
+ */ 
+typedef struct uf_st {
+    vid_t n; //!< number of elements
+    vid_t *parent; //!< parent of each element
+    uint8_t *rank; //!< upper bound on the height of each root
+} uf_t;
+
+extern uf_t* uf_create(vid_t n);
+extern void uf_destroy(uf_t *uf);
+extern void uf_reset(uf_t *uf);
+
+/**
+ * Finds the root of the set of an element, halving the path to it
+ * @param uf disjoint sets
+ * @param x element
+ * @return root of the set of x
+ */ 
+static inline vid_t uf_find(uf_t *uf, vid_t x)
+{
+    vid_t *parent = uf->parent;
+
+    while ( parent[x] != x ) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+
+    return x;
+}
+
+/**
+ * Finds the root of the set of an element without changing the forest,
+ * so that it can run while another thread updates it: halving only 
+ * moves parents closer to the root, so a walk still reaches it
+ * @param uf disjoint sets
+ * @param x element
+ * @return root of the set of x
+ */ 
+static inline vid_t uf_find_readonly(const uf_t *uf, vid_t x)
+{
+    while ( uf->parent[x] != x )
+        x = uf->parent[x];
+
+    return x;
+}
+
+/**
+ * Unions two sets by rank: the root of smaller rank points to the other
+ * @param uf disjoint sets
+ * @param r1 root of the first set
+ * @param r2 root of the second set (different from r1)
+ * @return root of the union
+ */ 
+static inline vid_t uf_union(uf_t *uf, vid_t r1, vid_t r2)
+{
+    if ( uf->rank[r1] < uf->rank[r2] ) {
+        uf->parent[r1] = r2;
+        return r2;
+    }
+    if ( uf->rank[r1] == uf->rank[r2] )
+        uf->rank[r1]++;
+    uf->parent[r2] = r1;
+
+    return r1;
+}
+
+/**
+ * Returns the linking priority of an element, a bijection of its id 
+ * that scatters neighboring ids
+ * @param x element
+ * @return priority (distinct for distinct elements)
+ */ 
+static inline vid_t uf_priority(vid_t x)
+{
+    x *= (vid_t)0x9e3779b97f4a7c15ULL; // odd, so invertible
+    return x ^ (x >> 16);
+}
+
+/**
+ * Finds the root of the set of an element, splitting the path to it; 
+ * safe against concurrent finds and unions
+ * @param uf disjoint sets
+ * @param x element
+ * @return root of the set of x at some point during the call
+ */ 
+static inline vid_t uf_find_atomic(uf_t *uf, vid_t x)
+{
+    vid_t p, gp, expected;
+
+    for ( ;; ) {
+        p = __atomic_load_n(&uf->parent[x], __ATOMIC_ACQUIRE);
+        if ( p == x )
+            return x;
+        gp = __atomic_load_n(&uf->parent[p], __ATOMIC_ACQUIRE);
+        if ( gp != p ) {
+            expected = p;
+            __atomic_compare_exchange_n(&uf->parent[x], &expected, gp, 1,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+        }
+        x = p;
+    }
+}
+
+/**
+ * Unions the sets of two elements; safe against concurrent finds and 
+ * unions
+ * @param uf disjoint sets
+ * @param a first element
+ * @param b second element
+ * @return 1 if this call merged two sets, 0 if they were already one
+ */ 
+static inline int uf_unite_atomic(uf_t *uf, vid_t a, vid_t b)
+{
+    vid_t t;
+
+    for ( ;; ) {
+        a = uf_find_atomic(uf, a);
+        b = uf_find_atomic(uf, b);
+        if ( a == b )
+            return 0;
+
+        // Link the root of lower priority below the other
+        if ( uf_priority(a) > uf_priority(b) ) {
+            t = a;
+            a = b;
+            b = t;
+        }
+        t = a;
+        if ( __atomic_compare_exchange_n(&uf->parent[a], &t, b, 0,
+                                         __ATOMIC_ACQ_REL, 
+                                         __ATOMIC_RELAXED) )
+            return 1;
+    }
+}
+
+/**
+ * Returns whether two elements are in the same set; safe against 
+ * concurrent finds and unions
+ * @param uf disjoint sets
+ * @param a first element
+ * @param b second element
+ * @return 1 if they were in the same set at some point during the 
+ *         call, 0 otherwise
+ */ 
+static inline int uf_same_atomic(uf_t *uf, vid_t a, vid_t b)
+{
+    for ( ;; ) {
+        a = uf_find_atomic(uf, a);
+        b = uf_find_atomic(uf, b);
+        if ( a == b )
+            return 1;
+        // a still a root: the two sets were apart when b was found
+        if ( __atomic_load_n(&uf->parent[a], __ATOMIC_ACQUIRE) == a )
+            return 0;
+    }
+}
+
+#endif 
@@ -0,0 +1,137 @@
+/**
+ * @file
+ * Concurrent union find stress test: threads unite random pairs and 
+ * query random pairs at once, and the resulting partition is checked 
+ * against the sequential union find over the same pairs
+ */  
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "flat_union_find.h"
+#include "union_find.h"
+
+#define N 100000
+#define NPAIRS (2 * N)
+#define NROUNDS 20
+
+/**
+ * Thread arguments
+ */ 
+typedef struct stress_targs_st {
+    uf_t *uf; //!< shared disjoint sets
+    const vid_t *pairs; //!< all pairs, 2 entries each
+    eid_t begin, end; //!< pairs of this thread
+    eid_t nmerged; //!< unions that merged two sets (output)
+} stress_targs_t;
+
+/**
+ * Unites the pairs of a thread, querying others in between
+ */ 
+static void* stress_thread(void *arg)
+{
+    stress_targs_t *ta = (stress_targs_t*)arg;
+    eid_t i;
+    unsigned int seed = (unsigned int)ta->begin;
+
+    ta->nmerged = 0;
+    for ( i = ta->begin; i < ta->end; i++ ) {
+        ta->nmerged += uf_unite_atomic(ta->uf, ta->pairs[2*i], 
+                                       ta->pairs[2*i+1]);
+        // Once united, always together
+        assert(uf_same_atomic(ta->uf, ta->pairs[2*i], ta->pairs[2*i+1]));
+        uf_same_atomic(ta->uf, rand_r(&seed) % N, rand_r(&seed) % N);
+    }
+
+    return NULL;
+}
+
+int main(int argc, char **argv)
+{
+    int nthreads = argc > 1 ? atoi(argv[1]) : 8;
+    int round, t;
+    eid_t i, npairs, nmerged, nsets;
+    vid_t v, ref, flat, *pairs, *ids, *ref_to_flat, *flat_to_ref;
+    uf_t *uf = uf_create(N);
+    forest_node_t **nodes;
+    pthread_t *tids;
+    stress_targs_t *targs;
+
+    pairs = (vid_t*)malloc(2 * NPAIRS * sizeof(vid_t));
+    ids = (vid_t*)malloc(N * sizeof(vid_t));
+    ref_to_flat = (vid_t*)malloc(N * sizeof(vid_t));
+    flat_to_ref = (vid_t*)malloc(N * sizeof(vid_t));
+    nodes = (forest_node_t**)malloc(N * sizeof(forest_node_t*));
+    tids = (pthread_t*)malloc(nthreads * sizeof(pthread_t));
+    targs = (stress_targs_t*)malloc(nthreads * sizeof(stress_targs_t));
+
+    srand(1);
+    for ( round = 0; round < NROUNDS; round++ ) {
+        // From a few large sets to many small ones
+        npairs = NPAIRS >> (round % 5);
+        for ( i = 0; i < 2 * npairs; i++ )
+            pairs[i] = rand() % N;
+
+        uf_reset(uf);
+        for ( t = 0; t < nthreads; t++ ) {
+            targs[t].uf = uf;
+            targs[t].pairs = pairs;
+            targs[t].begin = npairs * t / nthreads;
+            targs[t].end = npairs * (t + 1) / nthreads;
+            pthread_create(&tids[t], NULL, stress_thread, &targs[t]);
+        }
+        nmerged = 0;
+        for ( t = 0; t < nthreads; t++ ) {
+            pthread_join(tids[t], NULL);
+            nmerged += targs[t].nmerged;
+        }
+
+        // Sequential reference
+        for ( v = 0; v < N; v++ ) {
+            ids[v] = v;
+            nodes[v] = make_set(&ids[v]);
+        }
+        for ( i = 0; i < npairs; i++ ) {
+            forest_node_t *r1 = find_set(nodes[pairs[2*i]]);
+            forest_node_t *r2 = find_set(nodes[pairs[2*i+1]]);
+            if ( r1 != r2 )
+                union_sets(r1, r2);
+        }
+
+        // Same partition: the roots of both pair up one to one
+        for ( v = 0; v < N; v++ )
+            ref_to_flat[v] = flat_to_ref[v] = N;
+        nsets = 0;
+        for ( v = 0; v < N; v++ ) {
+            ref = (vid_t)((vid_t*)find_set(nodes[v])->value - ids);
+            flat = uf_find(uf, v);
+            if ( ref_to_flat[ref] == N ) {
+                assert(flat_to_ref[flat] == N);
+                ref_to_flat[ref] = flat;
+                flat_to_ref[flat] = ref;
+                nsets++;
+            }
+            assert(ref_to_flat[ref] == flat && flat_to_ref[flat] == ref);
+        }
+        // Every merge happened exactly once
+        assert(nmerged == N - nsets);
+
+        for ( v = 0; v < N; v++ )
+            destroy_set(nodes[v]);
+    }
+
+    fprintf(stdout, "Concurrent union find (%d threads): OK\n", nthreads);
+
+    free(targs);
+    free(tids);
+    free(nodes);
+    free(flat_to_ref);
+    free(ref_to_flat);
+    free(ids);
+    free(pairs);
+    uf_destroy(uf);
+
+    return 0;
+}
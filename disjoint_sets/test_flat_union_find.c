@@ -0,0 +1,62 @@
+/**
+ * @file
+ * Flat union find test program: random unions checked against a 
+ * naive labeling
+ */  
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "flat_union_find.h"
+
+#define N 10000
+
+int main(int argc, char **argv)
+{
+    uf_t *uf = uf_create(N);
+    vid_t i, j, a, b, r, lo, hi, nsets, *label;
+
+    // label[i] is the smallest element of the set of i
+    label = (vid_t*)malloc(N * sizeof(vid_t));
+    for ( i = 0; i < N; i++ )
+        label[i] = i;
+
+    srand(1);
+    nsets = N;
+    for ( i = 0; i < 4 * N; i++ ) {
+        a = rand() % N;
+        b = rand() % N;
+        assert((uf_find(uf, a) == uf_find(uf, b)) == (label[a] == label[b]));
+        if ( label[a] == label[b] )
+            continue;
+
+        r = uf_union(uf, uf_find(uf, a), uf_find(uf, b));
+        assert(r == uf_find(uf, a) && r == uf_find(uf, b));
+        assert(uf_find_readonly(uf, a) == r);
+        lo = label[a] < label[b] ? label[a] : label[b];
+        hi = label[a] < label[b] ? label[b] : label[a];
+        for ( j = 0; j < N; j++ )
+            if ( label[j] == hi )
+                label[j] = lo;
+        nsets--;
+    }
+
+    // Roots are their own parents; ranks bound the height by log2(N)
+    for ( i = 0, r = 0; i < N; i++ ) {
+        r += uf->parent[i] == i;
+        assert(uf->rank[i] < 14);
+    }
+    assert(r == nsets);
+
+    uf_reset(uf);
+    for ( i = 0; i < N; i++ )
+        assert(uf_find(uf, i) == i);
+
+    fprintf(stdout, "Flat union find: OK\n");
+
+    free(label);
+    uf_destroy(uf);
+
+    return 0;
+}
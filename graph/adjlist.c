@@ -7,20 +7,19 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <sys/types.h>
-#include <sys/stat.h>
-#include <fcntl.h>
 
-#include "util/util.h"
+#include "csr.h"
+#include "dimacs.h"
+#include "parallel.h"
 
 /**
  * Allocate and initialize adjacency list array
  * @param nvertices number of graph vertices
  * @return pointer to adjacency list
  */ 
-adjlist_t* adjlist_init(unsigned int nvertices)
+adjlist_t* adjlist_init(vid_t nvertices)
 {
-    unsigned int v;
+    vid_t v;
 
     adjlist_t *al = (adjlist_t*)malloc(sizeof(adjlist_t));
     if ( !al ) {
@@ -39,6 +38,12 @@ adjlist_t* adjlist_init(unsigned int nvertices)
     for ( v = 0; v < nvertices; v++ )
         al->adj[v] = NULL;
 
+#ifdef ADJLIST_ARENA
+    al->arena = arena_create(ADJLIST_ARENA_CHUNK_BYTES);
+#else
+    al->arena = NULL;
+#endif
+
     return al;
 }
 
@@ -52,8 +57,8 @@ adjlist_t* adjlist_init(unsigned int nvertices)
  * @return 0 in case of success, 1 if edge already exists
  */ 
 int adjlist_insert_edge(adjlist_t *al, 
-                        unsigned int s, 
-                        unsigned int t, 
+                        vid_t s, 
+                        vid_t t, 
                         weight_t w, 
                         adjlist_stats_t *stats)
 {
@@ -65,7 +70,10 @@ int adjlist_insert_edge(adjlist_t *al,
         }
     }
 
-    x = (node_t*)malloc(sizeof(node_t));
+    if ( al->arena )
+        x = (node_t*)arena_alloc(al->arena, sizeof(node_t));
+    else
+        x = (node_t*)malloc(sizeof(node_t));
     if ( !x ) {
         fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
         exit(EXIT_FAILURE);
@@ -84,7 +92,121 @@ int adjlist_insert_edge(adjlist_t *al,
 }
 
 
-#define GRAPH_MAX_LINE_LENGTH 64
+/**
+ * Per-thread state of adjlist_build()
+ */
+typedef struct {
+    vid_t vbegin, vend; //!< vertex range [vbegin,vend)
+    adjlist_t *al; //!< output adjacency list
+    csr_t *g; //!< deduplicated arcs
+    node_t *nodes; //!< preallocated nodes (NULL: malloc each node)
+} adjlist_build_targs_t;
+
+/**
+ * Links the adjacency lists of a vertex range
+ */
+static void* adjlist_build_link(void *args)
+{
+    adjlist_build_targs_t *ta = (adjlist_build_targs_t*)args;
+    vid_t v;
+    eid_t e;
+    node_t *x, *next;
+    csr_t *g = ta->g;
+
+    for ( v = ta->vbegin; v < ta->vend; v++ ) {
+        next = NULL;
+        // Walk the row backwards, so that the list keeps the row order
+        for ( e = g->offsets[v+1]; e > g->offsets[v]; e-- ) {
+            if ( ta->nodes ) {
+                x = &ta->nodes[e-1];
+            } else {
+                x = (node_t*)malloc(sizeof(node_t));
+                if ( !x ) {
+                    fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+                    exit(EXIT_FAILURE);
+                }
+            }
+            x->id = g->neighbors[e-1];
+            x->weight = g->weights[e-1];
+            x->next = next;
+            next = x;
+        }
+        ta->al->adj[v] = next;
+    }
+
+    return NULL;
+}
+
+/**
+ * Builds an adjacency list from a bulk list of arcs. This is equivalent 
+ * to inserting the arcs one by one with adjlist_insert_edge() (same 
+ * lists, same statistics), but parallel edges are detected by sorting 
+ * and deduplicating each vertex's arcs in parallel (see csr_build()), 
+ * instead of scanning the list of the source vertex on every insertion.
+ *
+ * @param nvertices number of vertices
+ * @param narcs number of arcs
+ * @param src arc sources
+ * @param dst arc targets
+ * @param weight arc weights
+ * @param stats pointer to statistics info
+ * @param is_undirected undirected flag
+ * @param nthreads number of threads (<=0 for all online processors)
+ * @return pointer to adjacency list array
+ */ 
+adjlist_t* adjlist_build(vid_t nvertices,
+                         eid_t narcs,
+                         const vid_t *src,
+                         const vid_t *dst,
+                         const weight_t *weight,
+                         adjlist_stats_t *stats,
+                         int is_undirected,
+                         int nthreads)
+{
+    int i;
+    csr_t *g;
+    adjlist_t *al;
+    node_t *nodes = NULL;
+    adjlist_build_targs_t *targs;
+
+    if ( nthreads <= 0 )
+        nthreads = parallel_default_nthreads();
+
+    g = csr_build(nvertices, narcs, src, dst, weight, 
+                  stats, is_undirected, nthreads);
+
+    al = adjlist_init(nvertices);
+    al->is_undirected = is_undirected;
+    al->nedges = g->nedges;
+
+    // With an arena, all nodes come from one block and every list 
+    // ends up contiguous in memory
+    if ( al->arena && g->nedges > 0 )
+        nodes = (node_t*)arena_alloc(al->arena, g->nedges * sizeof(node_t));
+
+    targs = (adjlist_build_targs_t*)malloc(nthreads * 
+                                           sizeof(adjlist_build_targs_t));
+    if ( !targs ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+    for ( i = 0; i < nthreads; i++ ) {
+        targs[i].vbegin = parallel_split_offsets(g->offsets, nvertices, 
+                                                 nthreads, i);
+        targs[i].vend = parallel_split_offsets(g->offsets, nvertices, 
+                                               nthreads, i+1);
+        targs[i].al = al;
+        targs[i].g = g;
+        targs[i].nodes = nodes;
+    }
+    parallel_run(adjlist_build_link, targs, 
+                 sizeof(adjlist_build_targs_t), nthreads);
+
+    free(targs);
+    csr_destroy(g);
+
+    return al;
+}
 
 /**
  * Allocates and initializes an adjacency list from a graph file.
@@ -95,6 +217,8 @@ int adjlist_insert_edge(adjlist_t *al,
  * a <u1> <v1> <w1>   // arc1 info
  * a <u2> <v2> <w2>   // arc2 info
  * ...
+ * The file is parsed in parallel by dimacs_read(), and the lists are 
+ * built in bulk by adjlist_build().
  *
  * @param filename graph file name
  * @param stats pointer to statistics info
@@ -105,55 +229,13 @@ adjlist_t* adjlist_read(const char *filename,
                         adjlist_stats_t *stats, 
                         int is_undirected)
 {
-    unsigned int nvertices, nedges, s, t;
-    weight_t weight;
-    int fd;
-    char *curr_line, dum1[2], dum2[2], a;
-
-    curr_line = (char*)malloc(GRAPH_MAX_LINE_LENGTH * sizeof(char));
-    if ( !curr_line ) {
-        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
-        exit(EXIT_FAILURE);
-    }
-
-    if ( (fd = open(filename, O_RDONLY)) < 0 ) {
-        perror("Error while opening file from disk: ");
-        exit(EXIT_FAILURE);
-    }
-    
-    // Ignore comments until "p sp ... " line
-    do {
-        readline(fd, curr_line, GRAPH_MAX_LINE_LENGTH);
-    } while ( curr_line[0] != 'p' );
-
-    sscanf(curr_line, "%s %s %u %u\n", dum1, dum2, &nvertices, &nedges);
-    adjlist_t *al = adjlist_init(nvertices);
-    al->is_undirected = is_undirected;
-    stats->nvertices = nvertices;
-    
-    while ( readline(fd, curr_line, GRAPH_MAX_LINE_LENGTH) > 0 ) {
-        sscanf(curr_line, "%c %u %u %f\n", &a, &s, &t, &weight);
-        
-        // Self-edge test
-        if ( s == t ) {
-            fprintf(stderr, "Self-edge found (and ingored)! \n");
-            stats->nloops++;
-            continue;
-        }
-
-        // Add edge
-        if ( !is_undirected ) 
-            adjlist_insert_edge(al, s-1, t-1, weight, stats);
-
-        // If graph is undirected, each edge is treated as bidirectional 
-        // and therefore a second reverse edge is inserted 
-        else {
-            adjlist_insert_edge(al, s-1, t-1, weight, stats);
-            adjlist_insert_edge(al, t-1, s-1, weight, stats);
-        }
-    }
+    dimacs_t *d;
+    adjlist_t *al;
 
-    free(curr_line);
+    d = dimacs_read(filename, 0);
+    al = adjlist_build(d->nvertices, d->narcs, d->src, d->dst, d->weight,
+                       stats, is_undirected, 0);
+    dimacs_destroy(d);
 
     return al;
 }
@@ -164,13 +246,14 @@ adjlist_t* adjlist_read(const char *filename,
  */ 
 void adjlist_print(adjlist_t *al)
 {
-    unsigned int v;
+    vid_t v;
     node_t *w;
 
     for ( v = 0; v < al->nvertices; v++ ) {
-        fprintf(stdout, "Node %u: ", v);
+        fprintf(stdout, "Node %" PRIvid ": ", v);
         for ( w = al->adj[v]; w != NULL; w = w->next ) {
-            fprintf(stdout, "(%u->%u) [%.2f] ", v, w->id, w->weight);
+            fprintf(stdout, "(%" PRIvid "->%" PRIvid ") [%.2f] ", 
+                    v, w->id, w->weight);
         }
         fprintf(stdout, "\n");
     }
@@ -182,15 +265,19 @@ void adjlist_print(adjlist_t *al)
  */ 
 void adjlist_destroy(adjlist_t *al)
 {
-    unsigned int v;
+    vid_t v;
     node_t *w, *next;
 
-    for ( v = 0; v < al->nvertices; v++ ) {
-        w = al->adj[v];
-        while ( w != NULL ) {
-            next = w->next;
-            free(w);
-            w = next;
+    if ( al->arena ) {
+        arena_destroy(al->arena);
+    } else {
+        for ( v = 0; v < al->nvertices; v++ ) {
+            w = al->adj[v];
+            while ( w != NULL ) {
+                next = w->next;
+                free(w);
+                w = next;
+            }
         }
     }
     free(al->adj);
@@ -222,13 +309,14 @@ void adjlist_print_stats(adjlist_stats_t *stats)
 {
     fprintf(stdout, "%s graph\n", 
             stats->is_undirected ? "Undirected" : "Directed"); 
-    fprintf(stdout, "Vertices: %u\n", stats->nvertices);
-    fprintf(stdout, "Edges: %u (%u if undirected)\n", 
+    fprintf(stdout, "Vertices: %" PRIvid "\n", stats->nvertices);
+    fprintf(stdout, "Edges: %" PRIeid " (%" PRIeid " if undirected)\n", 
             stats->nedges, stats->nedges/2);
-    fprintf(stdout, "Parallel edges: %u\n", stats->nparallel_edges);
-    fprintf(stdout, "Loops: %u\n", stats->nloops);
+    fprintf(stdout, "Parallel edges: %" PRIeid "\n", stats->nparallel_edges);
+    fprintf(stdout, "Loops: %" PRIeid "\n", stats->nloops);
     fprintf(stdout, "Average out-degree: %f\n", stats->avg_outdegree);
-    fprintf(stdout, "Maximum out-degree: %u\n", stats->max_outdegree);
+    fprintf(stdout, "Maximum out-degree: %" PRIeid "\n", 
+            stats->max_outdegree);
     fprintf(stdout, "Maximum edge weight: %f\n", stats->max_edge_weight);
 }
 
@@ -240,7 +328,8 @@ void adjlist_print_stats(adjlist_stats_t *stats)
 void adjlist_analyze(adjlist_t *al, adjlist_stats_t *stats)
 {
     int i;
-    unsigned int v, out_degrees[10], curr_degree;
+    vid_t v, out_degrees[10];
+    eid_t curr_degree;
     node_t *w;
 
     for ( i = 0; i < 10; i++)
@@ -272,9 +361,9 @@ void adjlist_analyze(adjlist_t *al, adjlist_stats_t *stats)
     stats->is_undirected = al->is_undirected;
     fprintf(stdout, "\n");
     for ( i = 0; i < 9; i++ )
-        fprintf(stdout, "#vertices with out-degree=%d: %u\n", 
+        fprintf(stdout, "#vertices with out-degree=%d: %" PRIvid "\n", 
                 i, out_degrees[i]);
-    fprintf(stdout, "#vertices with out-degree>=9: %u\n", 
+    fprintf(stdout, "#vertices with out-degree>=9: %" PRIvid "\n", 
             out_degrees[9]);
 
     fprintf(stdout, "\n\n");
@@ -6,13 +6,21 @@
 #ifndef ADJLIST_H_
 #define ADJLIST_H_
 
+#include "arena.h"
 #include "graph.h"
 
+/**
+ * When ADJLIST_ARENA is defined, adjacency list nodes are carved from 
+ * an arena owned by the adjacency list (instead of one malloc per node) 
+ * and are all released at once by adjlist_destroy().
+ */
+#define ADJLIST_ARENA_CHUNK_BYTES (4UL << 20)
+
 /**
  * Graph vertex
  */ 
 typedef struct node_st { 
-    unsigned int id; //!< unique id
+    vid_t id; //!< unique id
     weight_t weight; //!< vertex weight
     struct node_st *next; //!< next vertex in adjacency list
 } node_t;
@@ -21,34 +29,43 @@ typedef struct node_st {
  * Adjacency list graph representation
  */ 
 typedef struct adjlist_st { 
-    unsigned int nvertices; //!< number of vertices
-    unsigned int nedges; //!< number of edges
+    vid_t nvertices; //!< number of vertices
+    eid_t nedges; //!< number of edges
     node_t **adj; //!< array of adjacency lists
     int is_undirected; //!< undirected flag
+    arena_t *arena; //!< node allocator (NULL: nodes are malloc'd)
 } adjlist_t;
 
 /**
  * Keeps graph statistics
  */ 
 typedef struct adjlist_stats_st{
-    unsigned int nvertices;
-    unsigned int nedges;
-    unsigned int nparallel_edges; //!< number of parallel edges
-    unsigned int nloops; //!< number of self edges
+    vid_t nvertices;
+    eid_t nedges;
+    eid_t nparallel_edges; //!< number of parallel edges
+    eid_t nloops; //!< number of self edges
     float avg_outdegree; //!< average graph out-degree
-    unsigned int max_outdegree; //!< maximum graph out-degree
+    eid_t max_outdegree; //!< maximum graph out-degree
     weight_t max_edge_weight; //!< maximum edge weight
     int is_undirected; //!< undirected flag
 } adjlist_stats_t;
 
 
-extern adjlist_t* adjlist_init(unsigned int nvertices);
+extern adjlist_t* adjlist_init(vid_t nvertices);
 extern void adjlist_destroy(adjlist_t *al);
 extern int adjlist_insert_edge(adjlist_t *al, 
-                                unsigned int s, 
-                                unsigned int t, 
+                                vid_t s, 
+                                vid_t t, 
                                 weight_t w, 
                                 adjlist_stats_t *stats);
+extern adjlist_t* adjlist_build(vid_t nvertices,
+                                eid_t narcs,
+                                const vid_t *src,
+                                const vid_t *dst,
+                                const weight_t *weight,
+                                adjlist_stats_t *stats,
+                                int is_undirected,
+                                int nthreads);
 extern adjlist_t* adjlist_read(const char *filename, 
                                adjlist_stats_t *stats, 
                                int is_undirected);
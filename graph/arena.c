@@ -0,0 +1,107 @@
+/**
+ * @file
+ * Arena allocator function definitions
+ */
+
+#include "arena.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * Alignment of the objects returned by arena_alloc()
+ */
+#define ARENA_ALIGN 8
+
+/**
+ * Allocates a new chunk and makes it the head of the arena
+ * @param arena pointer to arena
+ * @param size usable bytes of the chunk
+ */
+static void arena_new_chunk(arena_t *arena, size_t size)
+{
+    arena_chunk_t *c = (arena_chunk_t*)malloc(sizeof(arena_chunk_t) + size);
+    if ( !c ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+
+    c->size = size;
+    c->used = 0;
+    c->next = arena->head;
+    arena->head = c;
+    arena->nchunks++;
+}
+
+/**
+ * Creates an empty arena
+ * @param chunk_size usable bytes of each chunk
+ * @return pointer to the arena
+ */
+arena_t* arena_create(size_t chunk_size)
+{
+    arena_t *arena = (arena_t*)malloc(sizeof(arena_t));
+    if ( !arena ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+
+    arena->head = NULL;
+    arena->chunk_size = chunk_size;
+    arena->nchunks = 0;
+
+    return arena;
+}
+
+/**
+ * Allocates memory from the arena
+ * @param arena pointer to arena
+ * @param bytes number of bytes requested
+ * @return pointer to the allocated memory
+ */
+void* arena_alloc(arena_t *arena, size_t bytes)
+{
+    arena_chunk_t *c = arena->head;
+    void *p;
+
+    bytes = (bytes + ARENA_ALIGN - 1) & ~((size_t)ARENA_ALIGN - 1);
+
+    // Large requests get a dedicated chunk, placed behind the head so
+    // that the free space of the head chunk is not wasted
+    if ( bytes > arena->chunk_size ) {
+        arena_new_chunk(arena, bytes);
+        c = arena->head;
+        c->used = bytes;
+        if ( c->next ) {
+            arena->head = c->next;
+            c->next = arena->head->next;
+            arena->head->next = c;
+        }
+        return c->data;
+    }
+
+    if ( !c || c->size - c->used < bytes ) {
+        arena_new_chunk(arena, arena->chunk_size);
+        c = arena->head;
+    }
+
+    p = c->data + c->used;
+    c->used += bytes;
+
+    return p;
+}
+
+/**
+ * Releases all memory of the arena, and the arena itself
+ * @param arena pointer to arena
+ */
+void arena_destroy(arena_t *arena)
+{
+    arena_chunk_t *c, *next;
+
+    for ( c = arena->head; c != NULL; c = next ) {
+        next = c->next;
+        free(c);
+    }
+    free(arena);
+}
@@ -0,0 +1,36 @@
+/**
+ * @file
+ * Arena (region) allocator type definitions and function declarations.
+ * Objects are carved sequentially from large chunks and can only be
+ * released all together, by destroying the arena.
+ */
+
+#ifndef ARENA_H_
+#define ARENA_H_
+
+#include <stddef.h>
+
+/**
+ * Memory chunk of an arena
+ */
+typedef struct arena_chunk_st {
+    struct arena_chunk_st *next; //!< previously allocated chunk
+    size_t size; //!< usable bytes in data
+    size_t used; //!< bytes already handed out
+    char data[]; //!< chunk memory
+} arena_chunk_t;
+
+/**
+ * Arena allocator
+ */
+typedef struct arena_st {
+    arena_chunk_t *head; //!< chunk currently being carved
+    size_t chunk_size; //!< usable bytes of each new chunk
+    size_t nchunks; //!< number of chunks allocated
+} arena_t;
+
+extern arena_t* arena_create(size_t chunk_size);
+extern void* arena_alloc(arena_t *arena, size_t bytes);
+extern void arena_destroy(arena_t *arena);
+
+#endif
@@ -0,0 +1,150 @@
+/**
+ * @file
+ * Binary file helper function definitions
+ */
+
+#include "binfile.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+/**
+ * Writes an array at a given file position, zero-padding up to it
+ * @param fp output file, positioned at or before pos
+ * @param pos file position of the array
+ * @param data array contents
+ * @param bytes array size in bytes
+ */
+void binfile_put(FILE *fp,
+                 uint64_t pos,
+                 const void *data,
+                 size_t bytes)
+{
+    long curr = ftell(fp);
+
+    while ( (uint64_t)curr < pos ) {
+        fputc(0, fp);
+        curr++;
+    }
+    if ( bytes > 0 && fwrite(data, 1, bytes, fp) != bytes ) {
+        perror("Error while writing binary file: ");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * Checks whether a file starts with a given magic string
+ * @param filename file name
+ * @param magic BINFILE_MAGIC_LEN-byte magic string
+ * @return 1 if the file starts with magic, 0 otherwise
+ */
+int binfile_has_magic(const char *filename, const char *magic)
+{
+    char buf[BINFILE_MAGIC_LEN];
+    int fd, ret = 0;
+
+    if ( (fd = open(filename, O_RDONLY)) < 0 )
+        return 0;
+    if ( read(fd, buf, sizeof(buf)) == sizeof(buf) &&
+         memcmp(buf, magic, sizeof(buf)) == 0 )
+        ret = 1;
+    close(fd);
+
+    return ret;
+}
+
+/**
+ * Maps a binary file read-only in memory, after checking that it is
+ * long enough to hold its header, that magic and version match and
+ * that the file size recorded in the header is the actual size.
+ * Exits on any mismatch.
+ * @param filename file name
+ * @param magic expected BINFILE_MAGIC_LEN-byte magic string
+ * @param version expected version
+ * @param header_size size of the header struct
+ * @param file_size_offset offset of the uint64_t file size header field
+ * @param len output; length of the mapping
+ * @return base address of the mapping
+ */
+char* binfile_map(const char *filename,
+                  const char *magic,
+                  uint32_t version,
+                  size_t header_size,
+                  size_t file_size_offset,
+                  size_t *len)
+{
+    int fd;
+    struct stat st;
+    char *base;
+    uint32_t file_version;
+    uint64_t file_size;
+
+    if ( (fd = open(filename, O_RDONLY)) < 0 ) {
+        perror("Error while opening file from disk: ");
+        exit(EXIT_FAILURE);
+    }
+    if ( fstat(fd, &st) < 0 ) {
+        perror("Error while reading file size: ");
+        exit(EXIT_FAILURE);
+    }
+    if ( (size_t)st.st_size < header_size ) {
+        fprintf(stderr, "%s: %s is too short\n", __FUNCTION__, filename);
+        exit(EXIT_FAILURE);
+    }
+
+    base = (char*)mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if ( base == MAP_FAILED ) {
+        perror("Error while mapping file: ");
+        exit(EXIT_FAILURE);
+    }
+    close(fd);
+
+    if ( memcmp(base, magic, BINFILE_MAGIC_LEN) != 0 ) {
+        fprintf(stderr, "%s: %s is not a %.8s file\n",
+                __FUNCTION__, filename, magic);
+        exit(EXIT_FAILURE);
+    }
+    memcpy(&file_version, base + BINFILE_MAGIC_LEN, sizeof(file_version));
+    if ( file_version != version ) {
+        fprintf(stderr, "%s: Unsupported %.8s version %u\n",
+                __FUNCTION__, magic, file_version);
+        exit(EXIT_FAILURE);
+    }
+    memcpy(&file_size, base + file_size_offset, sizeof(file_size));
+    if ( file_size != (uint64_t)st.st_size ) {
+        fprintf(stderr, "%s: %s is truncated\n", __FUNCTION__, filename);
+        exit(EXIT_FAILURE);
+    }
+
+    *len = st.st_size;
+    return base;
+}
+
+/**
+ * Checks that an array recorded in a mapped binary file starts at an
+ * aligned position and lies entirely within the file. Exits otherwise.
+ * @param filename file name, for the error message
+ * @param len length of the mapping
+ * @param pos file position of the array
+ * @param count number of array elements
+ * @param elem_bytes size of an array element
+ */
+void binfile_check_array(const char *filename,
+                         size_t len,
+                         uint64_t pos,
+                         uint64_t count,
+                         size_t elem_bytes)
+{
+    if ( pos % BINFILE_ALIGN != 0 || pos > len ||
+         count > (len - pos) / elem_bytes ) {
+        fprintf(stderr, "%s: %s has an array out of bounds\n",
+                __FUNCTION__, filename);
+        exit(EXIT_FAILURE);
+    }
+}
+
@@ -0,0 +1,46 @@
+/**
+ * @file
+ * Helpers shared by the memory-mapped binary file formats (CSR
+ * snapshots, ALT landmark tables, contraction hierarchies).
+ *
+ * Every such file starts with an 8-byte magic string followed by a
+ * uint32_t version, and stores its arrays at BINFILE_ALIGN-aligned
+ * positions after the header.
+ */
+
+#ifndef BINFILE_H_
+#define BINFILE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define BINFILE_MAGIC_LEN 8
+#define BINFILE_ALIGN 4096
+
+/**
+ * Rounds a file position up to the next BINFILE_ALIGN boundary
+ */
+static inline uint64_t binfile_align(uint64_t pos)
+{
+    return (pos + BINFILE_ALIGN - 1) & ~((uint64_t)BINFILE_ALIGN - 1);
+}
+
+extern void binfile_put(FILE *fp,
+                        uint64_t pos,
+                        const void *data,
+                        size_t bytes);
+extern int binfile_has_magic(const char *filename, const char *magic);
+extern char* binfile_map(const char *filename,
+                         const char *magic,
+                         uint32_t version,
+                         size_t header_size,
+                         size_t file_size_offset,
+                         size_t *len);
+extern void binfile_check_array(const char *filename,
+                                size_t len,
+                                uint64_t pos,
+                                uint64_t count,
+                                size_t elem_bytes);
+
+#endif
@@ -0,0 +1,273 @@
+/**
+ * @file
+ * Compressed CSR function definitions
+ */
+
+#include "ccsr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "parallel.h"
+#include "util/util.h"
+
+/**
+ * Per-thread state of csr_to_ccsr()
+ */
+typedef struct {
+    vid_t vbegin, vend; //!< vertex range [vbegin,vend)
+    csr_t *g; //!< input graph
+    vid_t *sorted; //!< sorted neighbor ids, parallel to g->neighbors
+    ccsr_t *out; //!< compressed graph
+} ccsr_targs_t;
+
+/**
+ * (id,weight) pair of a row, for sorting
+ */
+typedef struct {
+    vid_t id;
+    weight_t weight;
+} ccsr_pair_t;
+
+/**
+ * Compares two row entries by id
+ */
+static int ccsr_pair_compare(const void *p1, const void *p2)
+{
+    vid_t a = ((const ccsr_pair_t*)p1)->id, b = ((const ccsr_pair_t*)p2)->id;
+    return a < b ? -1 : (a > b);
+}
+
+/**
+ * Returns the number of bytes of the varint encoding of a value
+ */
+static inline eid_t ccsr_varint_len(uint64_t val)
+{
+    eid_t n = 1;
+
+    while ( val >= 0x80 ) {
+        val >>= 7;
+        n++;
+    }
+    return n;
+}
+
+/**
+ * Encodes a LEB128 varint
+ * @return position after the varint
+ */
+static inline uint8_t* ccsr_varint_encode(uint8_t *p, uint64_t val)
+{
+    while ( val >= 0x80 ) {
+        *p++ = (uint8_t)(val & 0x7f) | 0x80;
+        val >>= 7;
+    }
+    *p++ = (uint8_t)val;
+    return p;
+}
+
+/**
+ * Returns the gap encoded for neighbor w of v, given the previous
+ * neighbor (or v itself for the first neighbor)
+ */
+static inline uint64_t ccsr_gap(vid_t v, vid_t w, vid_t prev, int first)
+{
+    uint64_t d;
+
+    if ( !first )
+        return (uint64_t)(w - prev - 1);
+
+    // zigzag: non-negative differences d are encoded as 2d, negative
+    // ones as 2(-d)-1
+    d = (uint64_t)w - (uint64_t)v;
+    return w >= v ? d << 1 : ((~d) << 1) | 1;
+}
+
+/**
+ * First parallel phase of csr_to_ccsr(): sorts the rows of a vertex
+ * range and stores the encoded row sizes in out->byte_offsets[v+1]
+ */
+static void* ccsr_sort_rows(void *args)
+{
+    ccsr_targs_t *ta = (ccsr_targs_t*)args;
+    csr_t *g = ta->g;
+    ccsr_t *out = ta->out;
+    vid_t v;
+    eid_t e, i, deg, maxdeg = 0, bytes;
+    ccsr_pair_t *row;
+
+    for ( v = ta->vbegin; v < ta->vend; v++ ) {
+        deg = csr_degree(g, v);
+        maxdeg = deg > maxdeg ? deg : maxdeg;
+    }
+    row = (ccsr_pair_t*)malloc_safe((maxdeg+1) * sizeof(ccsr_pair_t));
+
+    for ( v = ta->vbegin; v < ta->vend; v++ ) {
+        deg = csr_degree(g, v);
+        for ( i = 0, e = g->offsets[v]; i < deg; i++, e++ ) {
+            row[i].id = g->neighbors[e];
+            row[i].weight = g->weights[e];
+        }
+        qsort(row, deg, sizeof(ccsr_pair_t), ccsr_pair_compare);
+
+        bytes = 0;
+        for ( i = 0, e = g->offsets[v]; i < deg; i++, e++ ) {
+            ta->sorted[e] = row[i].id;
+            out->weights[e] = row[i].weight;
+            bytes += ccsr_varint_len(ccsr_gap(v, row[i].id,
+                                              i ? row[i-1].id : v, i == 0));
+        }
+        out->byte_offsets[v+1] = bytes;
+    }
+
+    free(row);
+
+    return NULL;
+}
+
+/**
+ * Second parallel phase of csr_to_ccsr(): encodes the sorted rows of
+ * a vertex range at their byte offsets
+ */
+static void* ccsr_encode_rows(void *args)
+{
+    ccsr_targs_t *ta = (ccsr_targs_t*)args;
+    csr_t *g = ta->g;
+    vid_t v, prev;
+    eid_t e;
+    uint8_t *p;
+
+    for ( v = ta->vbegin; v < ta->vend; v++ ) {
+        p = ta->out->data + ta->out->byte_offsets[v];
+        prev = v;
+        for ( e = g->offsets[v]; e < g->offsets[v+1]; e++ ) {
+            p = ccsr_varint_encode(p, ccsr_gap(v, ta->sorted[e], prev,
+                                               e == g->offsets[v]));
+            prev = ta->sorted[e];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Compresses a CSR graph. Rows are sorted and encoded in parallel;
+ * the input graph is left untouched.
+ * @param g pointer to CSR graph (without parallel edges)
+ * @param nthreads number of threads (<=0 for all online processors)
+ * @return pointer to compressed CSR graph
+ */
+ccsr_t* csr_to_ccsr(csr_t *g, int nthreads)
+{
+    vid_t v;
+    int i;
+    ccsr_targs_t *targs;
+    vid_t *sorted;
+    ccsr_t *out = (ccsr_t*)malloc_safe(sizeof(ccsr_t));
+
+    out->nvertices = g->nvertices;
+    out->nedges = g->nedges;
+    out->is_undirected = g->is_undirected;
+    out->offsets = (eid_t*)malloc_safe((g->nvertices+1) * sizeof(eid_t));
+    out->byte_offsets = (eid_t*)malloc_safe((g->nvertices+1) *
+                                            sizeof(eid_t));
+    out->weights = (weight_t*)malloc_safe(g->nedges * sizeof(weight_t));
+    for ( v = 0; v <= g->nvertices; v++ )
+        out->offsets[v] = g->offsets[v];
+
+    if ( nthreads <= 0 )
+        nthreads = parallel_default_nthreads();
+    sorted = (vid_t*)malloc_safe(g->nedges * sizeof(vid_t));
+    targs = (ccsr_targs_t*)malloc_safe(nthreads * sizeof(ccsr_targs_t));
+    for ( i = 0; i < nthreads; i++ ) {
+        targs[i].vbegin = parallel_split_offsets(g->offsets, g->nvertices,
+                                                 nthreads, i);
+        targs[i].vend = parallel_split_offsets(g->offsets, g->nvertices,
+                                               nthreads, i+1);
+        targs[i].g = g;
+        targs[i].sorted = sorted;
+        targs[i].out = out;
+    }
+    parallel_run(ccsr_sort_rows, targs, sizeof(ccsr_targs_t), nthreads);
+
+    out->byte_offsets[0] = 0;
+    for ( v = 0; v < g->nvertices; v++ )
+        out->byte_offsets[v+1] += out->byte_offsets[v];
+    // One byte of slack, so that an empty graph still gets a buffer
+    out->data = (uint8_t*)malloc_safe(out->byte_offsets[g->nvertices] + 1);
+
+    parallel_run(ccsr_encode_rows, targs, sizeof(ccsr_targs_t), nthreads);
+
+    free(targs);
+    free(sorted);
+
+    return out;
+}
+
+/**
+ * Builds a compressed CSR graph from a graph file (see adjlist_read()
+ * for the format). The graph is built uncompressed by csr_build()
+ * first, and then compressed.
+ * @param filename graph file name
+ * @param stats pointer to statistics info
+ * @param is_undirected undirected flag
+ * @return pointer to compressed CSR graph
+ */
+ccsr_t* ccsr_read(const char *filename,
+                  adjlist_stats_t *stats,
+                  int is_undirected)
+{
+    csr_t *g;
+    ccsr_t *cg;
+
+    g = csr_read(filename, stats, is_undirected);
+    cg = csr_to_ccsr(g, 0);
+    csr_destroy(g);
+
+    return cg;
+}
+
+/**
+ * Destroys a compressed CSR graph
+ * @param g pointer to compressed CSR graph
+ */
+void ccsr_destroy(ccsr_t *g)
+{
+    free(g->offsets);
+    free(g->byte_offsets);
+    free(g->data);
+    free(g->weights);
+    free(g);
+}
+
+/**
+ * Returns the memory footprint of a compressed CSR graph
+ * @param g pointer to compressed CSR graph
+ * @return number of bytes used by its arrays
+ */
+size_t ccsr_bytes(ccsr_t *g)
+{
+    return 2 * (g->nvertices+1) * sizeof(eid_t) +
+           g->byte_offsets[g->nvertices] +
+           g->nedges * sizeof(weight_t);
+}
+
+/**
+ * Prints the compressed CSR graph
+ * @param g pointer to compressed CSR graph
+ */
+void ccsr_print(ccsr_t *g)
+{
+    vid_t v, w;
+    weight_t weight;
+    ccsr_iter_t it;
+
+    for ( v = 0; v < g->nvertices; v++ ) {
+        fprintf(stdout, "Node %" PRIvid ": ", v);
+        ccsr_iter_begin(g, v, &it);
+        while ( ccsr_iter_next(&it, &w, &weight) )
+            fprintf(stdout, "(%" PRIvid "->%" PRIvid ") [%.2f] ",
+                    v, w, weight);
+        fprintf(stdout, "\n");
+    }
+}
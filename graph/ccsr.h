@@ -0,0 +1,133 @@
+/**
+ * @file
+ * Compressed CSR type definitions and function declarations.
+ *
+ * The neighbors of every vertex are sorted by id and stored as a
+ * varint-encoded (LEB128) sequence of gaps: the first neighbor w0 of v
+ * as the zigzag-encoded difference w0-v, every following neighbor as
+ * the difference from the previous one minus one (neighbors are
+ * distinct). Weights are stored uncompressed in a separate array, in
+ * the same (sorted) order.
+ */
+
+#ifndef CCSR_H_
+#define CCSR_H_
+
+#include <stdint.h>
+
+#include "adjlist.h"
+#include "csr.h"
+#include "graph.h"
+
+/**
+ * Compressed CSR graph representation (read-only).
+ * The encoded neighbors of vertex v are stored at
+ * data[byte_offsets[v]..byte_offsets[v+1]-1] and their weights at
+ * weights[offsets[v]..offsets[v+1]-1].
+ */
+typedef struct ccsr_st {
+    vid_t nvertices; //!< number of vertices
+    eid_t nedges; //!< number of (directed) edges stored
+    eid_t *offsets; //!< per-vertex edge offsets, nvertices+1 entries
+    eid_t *byte_offsets; //!< per-vertex offsets into data, nvertices+1 entries
+    uint8_t *data; //!< encoded neighbor gaps
+    weight_t *weights; //!< edge weights
+    int is_undirected; //!< undirected flag
+} ccsr_t;
+
+/**
+ * Neighbor iterator
+ */
+typedef struct ccsr_iter_st {
+    const uint8_t *p; //!< next encoded gap
+    const weight_t *w; //!< next weight
+    eid_t left; //!< neighbors left
+    vid_t prev; //!< last neighbor returned (the vertex itself at first)
+    int first; //!< no neighbor returned yet
+} ccsr_iter_t;
+
+/**
+ * Decodes a LEB128 varint
+ * @param p address of the current position, advanced past the varint
+ * @return decoded value
+ */
+static inline uint64_t ccsr_varint_decode(const uint8_t **p)
+{
+    const uint8_t *q = *p;
+    uint64_t val = *q & 0x7f;
+    int shift = 7;
+
+    while ( *q++ & 0x80 ) {
+        val |= (uint64_t)(*q & 0x7f) << shift;
+        shift += 7;
+    }
+    *p = q;
+
+    return val;
+}
+
+/**
+ * Returns the out-degree of a vertex
+ * @param g pointer to compressed CSR graph
+ * @param v vertex id
+ * @return number of outgoing edges of v
+ */
+static inline eid_t ccsr_degree(const ccsr_t *g, vid_t v)
+{
+    return g->offsets[v+1] - g->offsets[v];
+}
+
+/**
+ * Positions an iterator before the first neighbor of a vertex
+ * @param g pointer to compressed CSR graph
+ * @param v vertex id
+ * @param it pointer to iterator
+ */
+static inline void ccsr_iter_begin(const ccsr_t *g, vid_t v, ccsr_iter_t *it)
+{
+    it->p = g->data + g->byte_offsets[v];
+    it->w = g->weights + g->offsets[v];
+    it->left = g->offsets[v+1] - g->offsets[v];
+    it->prev = v;
+    it->first = 1;
+}
+
+/**
+ * Decodes the next neighbor of an iterator
+ * @param it pointer to iterator
+ * @param w neighbor id
+ * @param weight edge weight
+ * @return 1 if a neighbor was decoded, 0 at the end of the row
+ */
+static inline int ccsr_iter_next(ccsr_iter_t *it, vid_t *w, weight_t *weight)
+{
+    uint64_t gap;
+
+    if ( it->left == 0 )
+        return 0;
+
+    gap = ccsr_varint_decode(&it->p);
+    if ( it->first ) {
+        // zigzag: even gaps are non-negative differences
+        it->prev = (vid_t)((uint64_t)it->prev +
+                           ((gap & 1) ? ~(gap >> 1) : (gap >> 1)));
+        it->first = 0;
+    } else {
+        it->prev = (vid_t)(it->prev + gap + 1);
+    }
+    *w = it->prev;
+    *weight = *it->w++;
+    it->left--;
+
+    return 1;
+}
+
+extern ccsr_t* csr_to_ccsr(csr_t *g, int nthreads);
+extern ccsr_t* ccsr_read(const char *filename,
+                         adjlist_stats_t *stats,
+                         int is_undirected);
+extern void ccsr_destroy(ccsr_t *g);
+extern size_t ccsr_bytes(ccsr_t *g);
+extern void ccsr_print(ccsr_t *g);
+
+#endif
@@ -0,0 +1,453 @@
+/**
+ * @file
+ * Compressed Sparse Row (CSR) function definitions
+ */
+
+#include "csr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+
+#include "dimacs.h"
+#include "parallel.h"
+#include "util/util.h"
+
+/**
+ * Allocates a CSR graph with room for a given number of edges
+ * @param nvertices number of graph vertices
+ * @param nedges number of (directed) edges
+ * @return pointer to CSR graph
+ */
+csr_t* csr_init(vid_t nvertices, eid_t nedges)
+{
+    csr_t *g = (csr_t*)malloc_safe(sizeof(csr_t));
+
+    g->nvertices = nvertices;
+    g->nedges = nedges;
+    g->is_undirected = 0;
+    g->mapping = NULL;
+    g->mapping_len = 0;
+    g->offsets = (eid_t*)malloc_safe((nvertices+1) * sizeof(eid_t));
+    g->neighbors = (vid_t*)malloc_safe(nedges * sizeof(vid_t));
+    g->weights = (weight_t*)malloc_safe(nedges * sizeof(weight_t));
+    g->offsets[0] = 0;
+
+    return g;
+}
+
+/**
+ * Destroys a CSR graph, unmapping it if it was loaded with csr_mmap()
+ * @param g pointer to CSR graph
+ */
+void csr_destroy(csr_t *g)
+{
+    if ( g->mapping ) {
+        munmap(g->mapping, g->mapping_len);
+    } else {
+        free(g->offsets);
+        free(g->neighbors);
+        free(g->weights);
+    }
+    free(g);
+}
+
+/**
+ * Converts an adjacency list to CSR representation.
+ * Neighbors of each vertex keep the order of the adjacency list.
+ * @param al pointer to adjacency list array
+ * @return pointer to created CSR graph
+ */
+csr_t* adjlist_to_csr(adjlist_t *al)
+{
+    vid_t v;
+    eid_t e = 0;
+    node_t *w;
+    csr_t *g = csr_init(al->nvertices, al->nedges);
+
+    g->is_undirected = al->is_undirected;
+
+    for ( v = 0; v < al->nvertices; v++ ) {
+        for ( w = al->adj[v]; w != NULL; w = w->next ) {
+            g->neighbors[e] = w->id;
+            g->weights[e] = w->weight;
+            e++;
+        }
+        g->offsets[v+1] = e;
+    }
+
+    return g;
+}
+
+/**
+ * Rows with at most this many entries are deduplicated by a quadratic
+ * scan; larger rows are sorted
+ */
+#define CSR_DEDUP_SCAN_MAX 32
+
+/**
+ * Per-thread state of csr_build()
+ */
+typedef struct {
+    vid_t vbegin, vend; //!< vertex range [vbegin,vend)
+    const eid_t *rows; //!< row offsets of the raw (unsorted) arcs
+    vid_t *ids; //!< raw arc targets, grouped by source
+    weight_t *weights; //!< raw arc weights, grouped by source
+    csr_t *g; //!< output graph
+    eid_t nparallel; //!< parallel edges dropped in the range
+    weight_t max_weight; //!< maximum weight of the edges kept in the range
+} csr_build_targs_t;
+
+/**
+ * (id,position) sort key of a row entry
+ */
+typedef struct {
+    vid_t id;
+    eid_t pos;
+} csr_key_t;
+
+/**
+ * Compares two (id,position) sort keys
+ */
+static int csr_key_compare(const void *k1, const void *k2)
+{
+    const csr_key_t *a = (const csr_key_t*)k1, *b = (const csr_key_t*)k2;
+
+    if ( a->id != b->id )
+        return a->id < b->id ? -1 : 1;
+    return a->pos < b->pos ? -1 : (a->pos > b->pos);
+}
+
+/**
+ * Drops the repeated ids of a row, keeping the first occurrence of 
+ * each, and reverses the row so that it matches the order of an 
+ * adjacency list built by adjlist_insert_edge() (which prepends).
+ * @param ids row ids
+ * @param weights row weights
+ * @param deg row length
+ * @param keys scratch buffer of deg entries
+ * @param keep scratch buffer of deg entries
+ * @return number of entries kept
+ */
+static eid_t csr_dedup_row(vid_t *ids,
+                           weight_t *weights,
+                           eid_t deg,
+                           csr_key_t *keys,
+                           char *keep)
+{
+    eid_t i, j, k;
+    vid_t tmp_id;
+    weight_t tmp_w;
+
+    if ( deg <= CSR_DEDUP_SCAN_MAX ) {
+        for ( i = 0; i < deg; i++ ) {
+            keep[i] = 1;
+            for ( j = 0; j < i; j++ ) {
+                if ( ids[j] == ids[i] ) {
+                    keep[i] = 0;
+                    break;
+                }
+            }
+        }
+    } else {
+        // Sorting by (id,position) puts the first occurrence of each id
+        // at the head of its group
+        for ( i = 0; i < deg; i++ ) {
+            keys[i].id = ids[i];
+            keys[i].pos = i;
+            keep[i] = 0;
+        }
+        qsort(keys, deg, sizeof(csr_key_t), csr_key_compare);
+        for ( i = 0; i < deg; i++ ) 
+            if ( i == 0 || keys[i].id != keys[i-1].id )
+                keep[keys[i].pos] = 1;
+    }
+
+    for ( i = 0, k = 0; i < deg; i++ ) {
+        if ( keep[i] ) {
+            ids[k] = ids[i];
+            weights[k] = weights[i];
+            k++;
+        }
+    }
+
+    for ( i = 0, j = k; i + 1 < j; i++, j-- ) {
+        tmp_id = ids[i];
+        ids[i] = ids[j-1];
+        ids[j-1] = tmp_id;
+        tmp_w = weights[i];
+        weights[i] = weights[j-1];
+        weights[j-1] = tmp_w;
+    }
+
+    return k;
+}
+
+/**
+ * First parallel phase of csr_build(): deduplicates the rows of a vertex
+ * range and stores the row lengths in g->offsets[v+1]
+ */
+static void* csr_build_dedup(void *args)
+{
+    csr_build_targs_t *ta = (csr_build_targs_t*)args;
+    vid_t v;
+    eid_t deg, kept, maxdeg = 0;
+    csr_key_t *keys;
+    char *keep;
+
+    for ( v = ta->vbegin; v < ta->vend; v++ ) {
+        deg = ta->rows[v+1] - ta->rows[v];
+        maxdeg = deg > maxdeg ? deg : maxdeg;
+    }
+    keys = (csr_key_t*)malloc_safe(maxdeg * sizeof(csr_key_t));
+    keep = (char*)malloc_safe(maxdeg * sizeof(char));
+
+    ta->nparallel = 0;
+    for ( v = ta->vbegin; v < ta->vend; v++ ) {
+        deg = ta->rows[v+1] - ta->rows[v];
+        kept = csr_dedup_row(ta->ids + ta->rows[v], 
+                             ta->weights + ta->rows[v], 
+                             deg, keys, keep);
+        ta->g->offsets[v+1] = kept;
+        ta->nparallel += deg - kept;
+    }
+
+    free(keys);
+    free(keep);
+
+    return NULL;
+}
+
+/**
+ * Second parallel phase of csr_build(): copies the deduplicated rows 
+ * of a vertex range to their final position, and finds their maximum 
+ * edge weight
+ */
+static void* csr_build_copy(void *args)
+{
+    csr_build_targs_t *ta = (csr_build_targs_t*)args;
+    csr_t *g = ta->g;
+    vid_t v;
+    eid_t i, src, dst;
+
+    ta->max_weight = 0;
+    for ( v = ta->vbegin; v < ta->vend; v++ ) {
+        src = ta->rows[v];
+        dst = g->offsets[v];
+        for ( i = 0; i < g->offsets[v+1] - g->offsets[v]; i++ ) {
+            g->neighbors[dst+i] = ta->ids[src+i];
+            g->weights[dst+i] = ta->weights[src+i];
+            if ( ta->weights[src+i] > ta->max_weight )
+                ta->max_weight = ta->weights[src+i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Builds a CSR graph from a bulk list of arcs.
+ * Self-edges are ignored and, for undirected graphs, each arc is also 
+ * inserted reversed. Arcs are bucketed by source with a counting pass 
+ * and a stable fill pass; each row is then deduplicated in parallel 
+ * (keeping the first occurrence of every parallel edge, as 
+ * adjlist_insert_edge() does). Neighbors end up in the same order as in 
+ * an adjacency list built by inserting the arcs one by one.
+ *
+ * @param nvertices number of vertices
+ * @param narcs number of arcs
+ * @param src arc sources
+ * @param dst arc targets
+ * @param weight arc weights
+ * @param stats pointer to statistics info
+ * @param is_undirected undirected flag
+ * @param nthreads number of threads (<=0 for all online processors)
+ * @return pointer to CSR graph
+ */
+csr_t* csr_build(vid_t nvertices,
+                 eid_t narcs,
+                 const vid_t *src,
+                 const vid_t *dst,
+                 const weight_t *weight,
+                 adjlist_stats_t *stats,
+                 int is_undirected,
+                 int nthreads)
+{
+    vid_t s, t, v, *ids;
+    eid_t i, k, nraw, *rows;
+    int j;
+    weight_t *weights;
+    csr_build_targs_t *targs;
+    csr_t *g;
+
+    stats->nvertices = nvertices;
+
+    // Counting pass: row lengths are accumulated in rows[v+2], so that
+    // after the prefix sum and the fill pass rows[] holds row offsets
+    rows = (eid_t*)malloc_safe((nvertices+2) * sizeof(eid_t));
+    for ( v = 0; v < nvertices+2; v++ )
+        rows[v] = 0;
+    for ( i = 0; i < narcs; i++ ) {
+        if ( src[i] == dst[i] ) {
+            fprintf(stderr, "Self-edge found (and ingored)! \n");
+            stats->nloops++;
+            continue;
+        }
+        rows[src[i]+2]++;
+        if ( is_undirected )
+            rows[dst[i]+2]++;
+    }
+    for ( v = 0; v < nvertices; v++ )
+        rows[v+2] += rows[v+1];
+    nraw = rows[nvertices+1];
+
+    // Fill pass: stable placement of arcs into their source's row.
+    // For undirected graphs the reverse arc follows the forward one.
+    ids = (vid_t*)malloc_safe(nraw * sizeof(vid_t));
+    weights = (weight_t*)malloc_safe(nraw * sizeof(weight_t));
+    for ( i = 0; i < narcs; i++ ) {
+        s = src[i];
+        t = dst[i];
+        if ( s == t )
+            continue;
+        k = rows[s+1]++;
+        ids[k] = t;
+        weights[k] = weight[i];
+        if ( is_undirected ) {
+            k = rows[t+1]++;
+            ids[k] = s;
+            weights[k] = weight[i];
+        }
+    }
+
+    g = (csr_t*)malloc_safe(sizeof(csr_t));
+    g->nvertices = nvertices;
+    g->is_undirected = is_undirected;
+    g->mapping = NULL;
+    g->mapping_len = 0;
+    g->offsets = (eid_t*)malloc_safe((nvertices+1) * sizeof(eid_t));
+
+    // Deduplicate rows in parallel, on vertex ranges of similar size
+    if ( nthreads <= 0 )
+        nthreads = parallel_default_nthreads();
+    targs = (csr_build_targs_t*)malloc_safe(nthreads * 
+                                            sizeof(csr_build_targs_t));
+    for ( j = 0; j < nthreads; j++ ) {
+        targs[j].vbegin = parallel_split_offsets(rows, nvertices, 
+                                                 nthreads, j);
+        targs[j].vend = parallel_split_offsets(rows, nvertices, 
+                                               nthreads, j+1);
+        targs[j].rows = rows;
+        targs[j].ids = ids;
+        targs[j].weights = weights;
+        targs[j].g = g;
+    }
+    parallel_run(csr_build_dedup, targs, sizeof(csr_build_targs_t), nthreads);
+
+    g->offsets[0] = 0;
+    for ( v = 0; v < nvertices; v++ )
+        g->offsets[v+1] += g->offsets[v];
+    g->nedges = g->offsets[nvertices];
+    for ( j = 0; j < nthreads; j++ )
+        stats->nparallel_edges += targs[j].nparallel;
+    stats->nedges += g->nedges;
+
+    g->neighbors = (vid_t*)malloc_safe(g->nedges * sizeof(vid_t));
+    g->weights = (weight_t*)malloc_safe(g->nedges * sizeof(weight_t));
+    parallel_run(csr_build_copy, targs, sizeof(csr_build_targs_t), nthreads);
+    for ( j = 0; j < nthreads; j++ )
+        if ( targs[j].max_weight > stats->max_edge_weight )
+            stats->max_edge_weight = targs[j].max_weight;
+
+    free(targs);
+    free(ids);
+    free(weights);
+    free(rows);
+
+    return g;
+}
+
+/**
+ * Builds a CSR graph directly from a graph file, without going through
+ * an adjacency list. The file format is the same as in adjlist_read();
+ * it is parsed in parallel by dimacs_read() and the graph is built by
+ * csr_build().
+ *
+ * @param filename graph file name
+ * @param stats pointer to statistics info
+ * @param is_undirected undirected flag
+ * @return pointer to CSR graph
+ */
+csr_t* csr_read(const char *filename,
+                adjlist_stats_t *stats,
+                int is_undirected)
+{
+    dimacs_t *d;
+    csr_t *g;
+
+    d = dimacs_read(filename, 0);
+    g = csr_build(d->nvertices, d->narcs, d->src, d->dst, d->weight,
+                  stats, is_undirected, 0);
+    dimacs_destroy(d);
+
+    return g;
+}
+
+/**
+ * Builds the transpose (reverse) of a CSR graph: edge (u,v) becomes 
+ * (v,u) with the same weight. Rows of the result are sorted by 
+ * neighbor id.
+ * @param g pointer to CSR graph
+ * @return pointer to the transposed graph
+ */
+csr_t* csr_transpose(csr_t *g)
+{
+    vid_t u, v;
+    eid_t e, *pos;
+    csr_t *t = csr_init(g->nvertices, g->nedges);
+
+    t->is_undirected = g->is_undirected;
+
+    // Count in-degrees, then turn them into offsets
+    for ( v = 0; v <= g->nvertices; v++ )
+        t->offsets[v] = 0;
+    for ( e = 0; e < g->nedges; e++ )
+        t->offsets[g->neighbors[e]+1]++;
+    for ( v = 0; v < g->nvertices; v++ )
+        t->offsets[v+1] += t->offsets[v];
+
+    // Scanning sources in order leaves every row sorted
+    pos = (eid_t*)malloc_safe(g->nvertices * sizeof(eid_t));
+    for ( v = 0; v < g->nvertices; v++ )
+        pos[v] = t->offsets[v];
+    for ( u = 0; u < g->nvertices; u++ ) {
+        for ( e = g->offsets[u]; e < g->offsets[u+1]; e++ ) {
+            v = g->neighbors[e];
+            t->neighbors[pos[v]] = u;
+            t->weights[pos[v]] = g->weights[e];
+            pos[v]++;
+        }
+    }
+    free(pos);
+
+    return t;
+}
+
+/**
+ * Prints the CSR graph
+ * @param g pointer to CSR graph
+ */
+void csr_print(csr_t *g)
+{
+    vid_t v;
+    eid_t e;
+
+    for ( v = 0; v < g->nvertices; v++ ) {
+        fprintf(stdout, "Node %" PRIvid ": ", v);
+        for ( e = g->offsets[v]; e < g->offsets[v+1]; e++ ) {
+            fprintf(stdout, "(%" PRIvid "->%" PRIvid ") [%.2f] ",
+                    v, g->neighbors[e], g->weights[e]);
+        }
+        fprintf(stdout, "\n");
+    }
+}
@@ -0,0 +1,59 @@
+/**
+ * @file
+ * Compressed Sparse Row (CSR) type definitions and function declarations
+ */
+
+#ifndef CSR_H_
+#define CSR_H_
+
+#include <stddef.h>
+
+#include "adjlist.h"
+#include "graph.h"
+
+/**
+ * CSR graph representation.
+ * The neighbors of vertex v are neighbors[offsets[v]..offsets[v+1]-1],
+ * and the corresponding edge weights are stored at the same positions
+ * of the weights array.
+ */
+typedef struct csr_st {
+    vid_t nvertices; //!< number of vertices
+    eid_t nedges; //!< number of (directed) edges stored
+    eid_t *offsets; //!< per-vertex offsets, nvertices+1 entries
+    vid_t *neighbors; //!< concatenated adjacency arrays
+    weight_t *weights; //!< edge weights, parallel to neighbors
+    int is_undirected; //!< undirected flag
+    void *mapping; //!< file mapping backing the arrays (NULL if malloc'd)
+    size_t mapping_len; //!< length of the file mapping
+} csr_t;
+
+/**
+ * Returns the out-degree of a vertex
+ * @param g pointer to CSR graph
+ * @param v vertex id
+ * @return number of outgoing edges of v
+ */
+static inline eid_t csr_degree(const csr_t *g, vid_t v)
+{
+    return g->offsets[v+1] - g->offsets[v];
+}
+
+extern csr_t* csr_init(vid_t nvertices, eid_t nedges);
+extern void csr_destroy(csr_t *g);
+extern csr_t* adjlist_to_csr(adjlist_t *al);
+extern csr_t* csr_build(vid_t nvertices,
+                        eid_t narcs,
+                        const vid_t *src,
+                        const vid_t *dst,
+                        const weight_t *weight,
+                        adjlist_stats_t *stats,
+                        int is_undirected,
+                        int nthreads);
+extern csr_t* csr_read(const char *filename,
+                       adjlist_stats_t *stats,
+                       int is_undirected);
+extern csr_t* csr_transpose(csr_t *g);
+extern void csr_print(csr_t *g);
+
+#endif
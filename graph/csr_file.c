@@ -0,0 +1,157 @@
+/**
+ * @file
+ * Binary CSR graph snapshot function definitions
+ */
+
+#include "csr_file.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "binfile.h"
+#include "util/util.h"
+
+/**
+ * Writes a CSR graph to a binary snapshot file
+ * @param g pointer to CSR graph
+ * @param filename output file name
+ */
+void csr_write_binary(csr_t *g, const char *filename)
+{
+    FILE *fp;
+    csr_file_header_t h;
+
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, CSR_FILE_MAGIC, sizeof(h.magic));
+    h.version = CSR_FILE_VERSION;
+    h.is_undirected = g->is_undirected;
+    h.weight_type = sizeof(weight_t) == 4 ? CSR_WEIGHT_FLOAT32
+                                          : CSR_WEIGHT_FLOAT64;
+    h.id_bytes = sizeof(g->neighbors[0]);
+    h.offset_bytes = sizeof(g->offsets[0]);
+    h.nvertices = g->nvertices;
+    h.nedges = g->nedges;
+    h.offsets_pos = binfile_align(sizeof(h));
+    h.neighbors_pos = binfile_align(h.offsets_pos +
+                                    (h.nvertices+1) * h.offset_bytes);
+    h.weights_pos = binfile_align(h.neighbors_pos + h.nedges * h.id_bytes);
+    h.file_size = h.weights_pos + h.nedges * sizeof(weight_t);
+
+    if ( !(fp = fopen(filename, "wb")) ) {
+        perror("Error while opening file for writing: ");
+        exit(EXIT_FAILURE);
+    }
+
+    binfile_put(fp, 0, &h, sizeof(h));
+    binfile_put(fp, h.offsets_pos, g->offsets,
+                (h.nvertices+1) * h.offset_bytes);
+    binfile_put(fp, h.neighbors_pos, g->neighbors, h.nedges * h.id_bytes);
+    binfile_put(fp, h.weights_pos, g->weights,
+                h.nedges * sizeof(weight_t));
+
+    if ( fclose(fp) != 0 ) {
+        perror("Error while writing graph file: ");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * Checks whether a file is a binary CSR snapshot
+ * @param filename file name
+ * @return 1 if the file starts with the snapshot magic, 0 otherwise
+ */
+int csr_is_binary(const char *filename)
+{
+    return binfile_has_magic(filename, CSR_FILE_MAGIC);
+}
+
+/**
+ * Checks that the arrays of a mapped snapshot form a valid graph: edge
+ * loops index neighbors[] by offsets[], and the rows by neighbor ids, 
+ * so offsets must rise from 0 to nedges and every neighbor id must be
+ * a vertex. Exits otherwise.
+ * @param g pointer to mapped CSR graph
+ * @param filename snapshot file name, for the error message
+ */
+static void csr_file_check(const csr_t *g, const char *filename)
+{
+    vid_t v;
+    eid_t e;
+
+    if ( g->offsets[0] != 0 || g->offsets[g->nvertices] != g->nedges ) {
+        fprintf(stderr, "%s: %s has inconsistent offsets\n",
+                __FUNCTION__, filename);
+        exit(EXIT_FAILURE);
+    }
+    for ( v = 0; v < g->nvertices; v++ ) {
+        if ( g->offsets[v] > g->offsets[v+1] ) {
+            fprintf(stderr, "%s: %s has decreasing offsets\n",
+                    __FUNCTION__, filename);
+            exit(EXIT_FAILURE);
+        }
+    }
+    for ( e = 0; e < g->nedges; e++ ) {
+        if ( g->neighbors[e] >= g->nvertices ) {
+            fprintf(stderr, "%s: %s has a neighbor id out of range\n",
+                    __FUNCTION__, filename);
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+/**
+ * Loads a binary snapshot by mapping it in memory. The arrays of the
+ * returned graph point directly into the (read-only) mapping; nothing
+ * is copied, but offsets and neighbor ids are validated, which reads 
+ * both arrays once. csr_destroy() releases the mapping.
+ * @param filename snapshot file name
+ * @return pointer to read-only CSR graph
+ */
+csr_t* csr_mmap(const char *filename)
+{
+    size_t len;
+    char *base;
+    csr_file_header_t *h;
+    csr_t *g;
+
+    base = binfile_map(filename, CSR_FILE_MAGIC, CSR_FILE_VERSION,
+                       sizeof(csr_file_header_t),
+                       offsetof(csr_file_header_t, file_size), &len);
+    h = (csr_file_header_t*)base;
+    if ( h->weight_type != (sizeof(weight_t) == 4 ? CSR_WEIGHT_FLOAT32
+                                                  : CSR_WEIGHT_FLOAT64) ||
+         h->id_bytes != sizeof(((csr_t*)0)->neighbors[0]) ||
+         h->offset_bytes != sizeof(((csr_t*)0)->offsets[0]) ) {
+        fprintf(stderr, "%s: Snapshot type widths do not match this build\n",
+                __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+    // nvertices+1 offsets are checked below, so that count must not wrap
+    if ( h->nvertices > VID_MAX || h->nvertices == UINT64_MAX ) {
+        fprintf(stderr, "%s: %s has too many vertices for this build\n",
+                __FUNCTION__, filename);
+        exit(EXIT_FAILURE);
+    }
+    binfile_check_array(filename, len, h->offsets_pos, h->nvertices + 1,
+                        h->offset_bytes);
+    binfile_check_array(filename, len, h->neighbors_pos, h->nedges,
+                        h->id_bytes);
+    binfile_check_array(filename, len, h->weights_pos, h->nedges,
+                        sizeof(weight_t));
+
+    g = (csr_t*)malloc_safe(sizeof(csr_t));
+    g->nvertices = h->nvertices;
+    g->nedges = h->nedges;
+    g->is_undirected = h->is_undirected;
+    g->offsets = (void*)(base + h->offsets_pos);
+    g->neighbors = (void*)(base + h->neighbors_pos);
+    g->weights = (weight_t*)(base + h->weights_pos);
+    g->mapping = base;
+    g->mapping_len = len;
+
+    csr_file_check(g, filename);
+
+    return g;
+}
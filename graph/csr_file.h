@@ -0,0 +1,52 @@
+/**
+ * @file
+ * Binary CSR graph snapshot type definitions and function declarations.
+ *
+ * File layout (all integers in host byte order):
+ *   header (csr_file_header_t), zero-padded to CSR_FILE_ALIGN
+ *   offsets array (nvertices+1 entries), zero-padded to CSR_FILE_ALIGN
+ *   neighbors array (nedges entries), zero-padded to CSR_FILE_ALIGN
+ *   weights array (nedges entries)
+ */
+
+#ifndef CSR_FILE_H_
+#define CSR_FILE_H_
+
+#include <stdint.h>
+
+#include "binfile.h"
+#include "csr.h"
+
+#define CSR_FILE_MAGIC "GRAPHCSR"
+#define CSR_FILE_VERSION 1
+#define CSR_FILE_ALIGN BINFILE_ALIGN
+
+/**
+ * Edge weight type codes
+ */
+enum { CSR_WEIGHT_FLOAT32 = 1, CSR_WEIGHT_FLOAT64 };
+
+/**
+ * Snapshot header
+ */
+typedef struct csr_file_header_st {
+    char magic[8]; //!< CSR_FILE_MAGIC, not NUL-terminated
+    uint32_t version; //!< CSR_FILE_VERSION
+    uint32_t is_undirected; //!< undirected flag
+    uint32_t weight_type; //!< one of CSR_WEIGHT_*
+    uint32_t id_bytes; //!< size of a vertex id
+    uint32_t offset_bytes; //!< size of an edge offset
+    uint32_t reserved; //!< zero
+    uint64_t nvertices; //!< number of vertices
+    uint64_t nedges; //!< number of (directed) edges
+    uint64_t offsets_pos; //!< file position of the offsets array
+    uint64_t neighbors_pos; //!< file position of the neighbors array
+    uint64_t weights_pos; //!< file position of the weights array
+    uint64_t file_size; //!< total file size
+} csr_file_header_t;
+
+extern void csr_write_binary(csr_t *g, const char *filename);
+extern csr_t* csr_mmap(const char *filename);
+extern int csr_is_binary(const char *filename);
+
+#endif
@@ -0,0 +1,317 @@
+/**
+ * @file
+ * Parallel DIMACS graph file loader.
+ *
+ * The file is mapped in memory and split into one chunk per thread, with
+ * chunk boundaries moved forward to the next line start. A first pass
+ * counts the "a" lines of each chunk; an exclusive prefix sum over the
+ * counts gives every thread its output offset, and a second pass parses
+ * the arcs straight into their final position. The resulting arc arrays
+ * are therefore in file order, regardless of the number of threads.
+ */
+
+#include "dimacs.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "parallel.h"
+#include "util/util.h"
+
+/**
+ * Chunks smaller than this are not worth a thread of their own
+ */
+#define DIMACS_MIN_CHUNK_BYTES (1 << 20)
+
+/**
+ * Per-thread loader state
+ */
+typedef struct {
+    const char *begin; //!< first byte of the chunk (a line start)
+    const char *end; //!< one past the last byte of the chunk
+    eid_t narcs; //!< number of "a" lines in the chunk
+    eid_t offset; //!< position of the first arc in the output
+    dimacs_t *d; //!< output arcs
+} dimacs_targs_t;
+
+/**
+ * Returns a pointer to the beginning of the line following p
+ */
+static inline const char* next_line(const char *p, const char *end)
+{
+    while ( p < end && *p != '\n' )
+        p++;
+    return p < end ? p + 1 : end;
+}
+
+/**
+ * Skips spaces and tabs
+ */
+static inline const char* skip_blanks(const char *p, const char *end)
+{
+    while ( p < end && (*p == ' ' || *p == '\t') )
+        p++;
+    return p;
+}
+
+/**
+ * Parses an unsigned decimal integer
+ * @param p current position
+ * @param end end of buffer
+ * @param val parsed value
+ * @return position after the number
+ */
+static inline const char* parse_uint(const char *p,
+                                     const char *end,
+                                     uint64_t *val)
+{
+    uint64_t v = 0;
+
+    p = skip_blanks(p, end);
+    while ( p < end && *p >= '0' && *p <= '9' ) {
+        v = v * 10 + (uint64_t)(*p - '0');
+        p++;
+    }
+    *val = v;
+
+    return p;
+}
+
+/**
+ * Returns 10^n as a double (exact for n <= 22)
+ */
+static inline double dimacs_pow10(int n)
+{
+    double r = 1.0;
+    while ( n-- > 0 )
+        r *= 10.0;
+    return r;
+}
+
+/**
+ * Parses a decimal floating point number ([-+]digits[.digits][e[-+]digits])
+ * @param p current position
+ * @param end end of buffer
+ * @param val parsed value
+ * @return position after the number
+ */
+static inline const char* parse_weight(const char *p,
+                                       const char *end,
+                                       weight_t *val)
+{
+    unsigned long long mant = 0;
+    double v;
+    int neg = 0, exp = 0, exp_neg = 0, frac_digits = 0;
+
+    p = skip_blanks(p, end);
+    if ( p < end && (*p == '-' || *p == '+') ) {
+        neg = (*p == '-');
+        p++;
+    }
+    while ( p < end && *p >= '0' && *p <= '9' ) {
+        mant = mant * 10 + (*p - '0');
+        p++;
+    }
+    if ( p < end && *p == '.' ) {
+        p++;
+        while ( p < end && *p >= '0' && *p <= '9' ) {
+            mant = mant * 10 + (*p - '0');
+            frac_digits++;
+            p++;
+        }
+    }
+    if ( p < end && (*p == 'e' || *p == 'E') ) {
+        p++;
+        if ( p < end && (*p == '-' || *p == '+') ) {
+            exp_neg = (*p == '-');
+            p++;
+        }
+        while ( p < end && *p >= '0' && *p <= '9' ) {
+            exp = exp * 10 + (*p - '0');
+            p++;
+        }
+    }
+
+    // Divide once by an exact power of ten, so that plain decimal
+    // weights round the same way as with sscanf()
+    exp = (exp_neg ? -exp : exp) - frac_digits;
+    v = (double)mant;
+    while ( exp > 0 ) {
+        v *= 10.0;
+        exp--;
+    }
+    if ( exp < 0 )
+        v /= dimacs_pow10(-exp);
+    *val = (weight_t)(neg ? -v : v);
+
+    return p;
+}
+
+/**
+ * First pass: counts the "a" lines of a chunk
+ */
+static void* dimacs_count(void *args)
+{
+    dimacs_targs_t *ta = (dimacs_targs_t*)args;
+    const char *p = ta->begin;
+    eid_t n = 0;
+
+    while ( p < ta->end ) {
+        if ( *p == 'a' )
+            n++;
+        p = next_line(p, ta->end);
+    }
+    ta->narcs = n;
+
+    return NULL;
+}
+
+/**
+ * Second pass: parses the "a" lines of a chunk into the output arrays
+ */
+static void* dimacs_fill(void *args)
+{
+    dimacs_targs_t *ta = (dimacs_targs_t*)args;
+    const char *p = ta->begin, *end = ta->end;
+    eid_t i = ta->offset;
+    uint64_t s, t;
+    weight_t w;
+    dimacs_t *d = ta->d;
+
+    while ( p < end ) {
+        if ( *p == 'a' ) {
+            p = parse_uint(p + 1, end, &s);
+            p = parse_uint(p, end, &t);
+            p = parse_weight(p, end, &w);
+            d->src[i] = s - 1;
+            d->dst[i] = t - 1;
+            d->weight[i] = w;
+            i++;
+        }
+        p = next_line(p, end);
+    }
+
+    return NULL;
+}
+
+/**
+ * Reads a graph file in "coord" format (see adjlist_read()) using
+ * a memory mapping and multiple threads.
+ * @param filename graph file name
+ * @param nthreads number of threads to use (<=0 for all online processors)
+ * @return pointer to the arcs read
+ */
+dimacs_t* dimacs_read(const char *filename, int nthreads)
+{
+    int fd, i;
+    struct stat st;
+    const char *buf, *p, *end, *body;
+    eid_t total;
+    uint64_t val;
+    size_t chunk;
+    dimacs_targs_t *targs;
+    dimacs_t *d;
+
+    if ( (fd = open(filename, O_RDONLY)) < 0 ) {
+        perror("Error while opening file from disk: ");
+        exit(EXIT_FAILURE);
+    }
+    if ( fstat(fd, &st) < 0 ) {
+        perror("Error while reading file size: ");
+        exit(EXIT_FAILURE);
+    }
+    if ( st.st_size == 0 ) {
+        fprintf(stderr, "%s: Empty graph file %s\n", __FUNCTION__, filename);
+        exit(EXIT_FAILURE);
+    }
+
+    buf = (const char*)mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if ( buf == MAP_FAILED ) {
+        perror("Error while mapping file: ");
+        exit(EXIT_FAILURE);
+    }
+    close(fd);
+    madvise((void*)buf, st.st_size, MADV_SEQUENTIAL);
+    end = buf + st.st_size;
+
+    d = (dimacs_t*)malloc_safe(sizeof(dimacs_t));
+
+    // Ignore comments until "p sp ... " line
+    p = buf;
+    while ( p < end && *p != 'p' )
+        p = next_line(p, end);
+    if ( p == end ) {
+        fprintf(stderr, "%s: No problem line in %s\n", __FUNCTION__, filename);
+        exit(EXIT_FAILURE);
+    }
+    p = skip_blanks(p + 1, end);
+    while ( p < end && *p != ' ' && *p != '\t' )
+        p++;
+    p = parse_uint(p, end, &val);
+    if ( val > VID_MAX ) {
+        fprintf(stderr, "%s: %s has more vertices than vid_t can hold "
+                        "(rebuild with -DGRAPH_64BIT_IDS)\n", 
+                __FUNCTION__, filename);
+        exit(EXIT_FAILURE);
+    }
+    d->nvertices = (vid_t)val;
+    p = parse_uint(p, end, &val);
+    d->nedges = val;
+    body = next_line(p, end);
+
+    // Split the body into line-aligned chunks
+    if ( nthreads <= 0 )
+        nthreads = parallel_default_nthreads();
+    if ( (size_t)(end - body) / nthreads < DIMACS_MIN_CHUNK_BYTES )
+        nthreads = (end - body) / DIMACS_MIN_CHUNK_BYTES + 1;
+
+    targs = (dimacs_targs_t*)malloc_safe(nthreads * sizeof(dimacs_targs_t));
+    chunk = (end - body) / nthreads;
+    p = body;
+    for ( i = 0; i < nthreads; i++ ) {
+        targs[i].begin = p;
+        if ( i == nthreads - 1 )
+            p = end;
+        else if ( p < body + (i+1) * chunk )
+            p = next_line(body + (i+1) * chunk - 1, end);
+        targs[i].end = p;
+        targs[i].d = d;
+    }
+
+    parallel_run(dimacs_count, targs, sizeof(dimacs_targs_t), nthreads);
+
+    total = 0;
+    for ( i = 0; i < nthreads; i++ ) {
+        targs[i].offset = total;
+        total += targs[i].narcs;
+    }
+
+    d->narcs = total;
+    d->src = (vid_t*)malloc_safe(total * sizeof(vid_t));
+    d->dst = (vid_t*)malloc_safe(total * sizeof(vid_t));
+    d->weight = (weight_t*)malloc_safe(total * sizeof(weight_t));
+
+    parallel_run(dimacs_fill, targs, sizeof(dimacs_targs_t), nthreads);
+
+    free(targs);
+    munmap((void*)buf, st.st_size);
+
+    return d;
+}
+
+/**
+ * Destroys the arcs read by dimacs_read()
+ * @param d pointer to arcs
+ */
+void dimacs_destroy(dimacs_t *d)
+{
+    free(d->src);
+    free(d->dst);
+    free(d->weight);
+    free(d);
+}
@@ -0,0 +1,28 @@
+/**
+ * @file
+ * Parallel DIMACS graph file loader type definitions and
+ * function declarations
+ */
+
+#ifndef DIMACS_H_
+#define DIMACS_H_
+
+#include "graph.h"
+
+/**
+ * Arcs of a DIMACS graph file, in file order. Vertex ids are 0-based.
+ * Self-loops are kept; it is up to the caller to skip them.
+ */
+typedef struct dimacs_st {
+    vid_t nvertices; //!< number of vertices ("p" line)
+    eid_t nedges; //!< number of edges ("p" line)
+    eid_t narcs; //!< number of "a" lines actually found
+    vid_t *src; //!< arc source vertices
+    vid_t *dst; //!< arc target vertices
+    weight_t *weight; //!< arc weights
+} dimacs_t;
+
+extern dimacs_t* dimacs_read(const char *filename, int nthreads);
+extern void dimacs_destroy(dimacs_t *d);
+
+#endif
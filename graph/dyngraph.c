@@ -0,0 +1,419 @@
+/**
+ * @file
+ * Dynamic graph function definitions
+ */
+
+#include "dyngraph.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "parallel.h"
+#include "util/util.h"
+
+/**
+ * Minimum number of entries allocated for a non-empty row
+ */
+#define DYN_ROW_MIN_CAP 4
+
+/**
+ * Allocates an empty dynamic graph
+ * @param nvertices number of vertices
+ * @param is_undirected undirected flag
+ * @return pointer to dynamic graph
+ */
+dyngraph_t* dyngraph_create(vid_t nvertices, int is_undirected)
+{
+    dyngraph_t *g = (dyngraph_t*)malloc_safe(sizeof(dyngraph_t));
+
+    g->nvertices = nvertices;
+    g->nedges = 0;
+    g->is_undirected = is_undirected;
+    g->rows = (dyn_row_t*)malloc_safe(nvertices * sizeof(dyn_row_t));
+    memset(g->rows, 0, nvertices * sizeof(dyn_row_t));
+
+    return g;
+}
+
+/**
+ * Resizes a row to hold at least n entries, with slack for growth.
+ * Rows shrink when they become less than a quarter full.
+ */
+static void dyn_row_reserve(dyn_row_t *row, eid_t n)
+{
+    eid_t cap = row->cap;
+
+    if ( n > cap ) {
+        cap = cap ? cap : DYN_ROW_MIN_CAP;
+        while ( cap < n )
+            cap *= 2;
+    } else if ( n < cap / 4 && cap > DYN_ROW_MIN_CAP ) {
+        cap = n * 2 > DYN_ROW_MIN_CAP ? n * 2 : DYN_ROW_MIN_CAP;
+    }
+    if ( cap == row->cap )
+        return;
+
+    row->edges = (dyn_edge_t*)realloc(row->edges, cap * sizeof(dyn_edge_t));
+    if ( !row->edges ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+    row->cap = cap;
+}
+
+/**
+ * Compares two row entries by neighbor id
+ */
+static int dyn_edge_compare(const void *e1, const void *e2)
+{
+    vid_t a = ((const dyn_edge_t*)e1)->id, b = ((const dyn_edge_t*)e2)->id;
+    return a < b ? -1 : (a > b);
+}
+
+/**
+ * Per-thread state of csr_to_dyngraph()
+ */
+typedef struct {
+    vid_t vbegin, vend; //!< vertex range [vbegin,vend)
+    csr_t *csr; //!< input graph
+    dyngraph_t *g; //!< output graph
+} dyn_build_targs_t;
+
+/**
+ * Copies and sorts the rows of a vertex range
+ */
+static void* dyn_build_rows(void *args)
+{
+    dyn_build_targs_t *ta = (dyn_build_targs_t*)args;
+    vid_t v;
+    eid_t e, i;
+    dyn_row_t *row;
+
+    for ( v = ta->vbegin; v < ta->vend; v++ ) {
+        row = &ta->g->rows[v];
+        dyn_row_reserve(row, csr_degree(ta->csr, v));
+        for ( e = ta->csr->offsets[v], i = 0; e < ta->csr->offsets[v+1];
+              e++, i++ ) {
+            row->edges[i].id = ta->csr->neighbors[e];
+            row->edges[i].weight = ta->csr->weights[e];
+        }
+        row->deg = i;
+        if ( row->deg > 1 )
+            qsort(row->edges, row->deg, sizeof(dyn_edge_t),
+                  dyn_edge_compare);
+    }
+
+    return NULL;
+}
+
+/**
+ * Creates a dynamic graph holding the edges of a CSR graph
+ * @param csr pointer to CSR graph (without parallel edges)
+ * @param nthreads number of threads (<=0 for all online processors)
+ * @return pointer to dynamic graph
+ */
+dyngraph_t* csr_to_dyngraph(csr_t *csr, int nthreads)
+{
+    int i;
+    dyn_build_targs_t *targs;
+    dyngraph_t *g = dyngraph_create(csr->nvertices, csr->is_undirected);
+
+    g->nedges = csr->nedges;
+
+    if ( nthreads <= 0 )
+        nthreads = parallel_default_nthreads();
+    targs = (dyn_build_targs_t*)malloc_safe(nthreads *
+                                            sizeof(dyn_build_targs_t));
+    for ( i = 0; i < nthreads; i++ ) {
+        targs[i].vbegin = parallel_split_offsets(csr->offsets, csr->nvertices,
+                                                 nthreads, i);
+        targs[i].vend = parallel_split_offsets(csr->offsets, csr->nvertices,
+                                               nthreads, i+1);
+        targs[i].csr = csr;
+        targs[i].g = g;
+    }
+    parallel_run(dyn_build_rows, targs, sizeof(dyn_build_targs_t), nthreads);
+    free(targs);
+
+    return g;
+}
+
+/**
+ * Destroys a dynamic graph
+ * @param g pointer to dynamic graph
+ */
+void dyngraph_destroy(dyngraph_t *g)
+{
+    vid_t v;
+
+    for ( v = 0; v < g->nvertices; v++ )
+        free(g->rows[v].edges);
+    free(g->rows);
+    free(g);
+}
+
+/**
+ * Orders operations by (src, dst)
+ */
+static inline int dyn_op_less(const dyn_op_t *a, const dyn_op_t *b)
+{
+    return a->src < b->src || (a->src == b->src && a->dst < b->dst);
+}
+
+/**
+ * Sorts a batch of operations by (src, dst). The sort is stable, so
+ * operations on the same edge keep their relative order.
+ * @param ops operations
+ * @param nops number of operations
+ */
+void dyngraph_sort_batch(dyn_op_t *ops, eid_t nops)
+{
+    eid_t width, lo, mid, hi, i, j, k;
+    dyn_op_t *tmp, *src = ops, *dst, *swap;
+
+    if ( nops < 2 )
+        return;
+
+    // Bottom-up merge sort
+    tmp = (dyn_op_t*)malloc_safe(nops * sizeof(dyn_op_t));
+    dst = tmp;
+    for ( width = 1; width < nops; width *= 2 ) {
+        for ( lo = 0; lo < nops; lo += 2 * width ) {
+            mid = lo + width < nops ? lo + width : nops;
+            hi = lo + 2 * width < nops ? lo + 2 * width : nops;
+            for ( i = lo, j = mid, k = lo; k < hi; k++ ) {
+                if ( i < mid && (j >= hi || !dyn_op_less(&src[j], &src[i])) )
+                    dst[k] = src[i++];
+                else
+                    dst[k] = src[j++];
+            }
+        }
+        swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if ( src != ops )
+        memcpy(ops, src, nops * sizeof(dyn_op_t));
+    free(tmp);
+}
+
+/**
+ * Per-thread state of dyngraph_apply()
+ */
+typedef struct {
+    eid_t begin, end; //!< operation range [begin,end), whole sources
+    const dyn_op_t *ops; //!< sorted operations
+    dyngraph_t *g; //!< graph
+    dyn_stats_t stats; //!< effective operations of the range
+} dyn_apply_targs_t;
+
+/**
+ * Merges the operations of one source vertex into its row
+ * @param row source row
+ * @param ops operations of the source, sorted by dst
+ * @param nops number of operations
+ * @param out scratch buffer of row->deg + nops entries
+ * @param stats effective operation counters
+ */
+static void dyn_merge_row(dyn_row_t *row,
+                          const dyn_op_t *ops,
+                          eid_t nops,
+                          dyn_edge_t *out,
+                          dyn_stats_t *stats)
+{
+    eid_t i = 0, j = 0, n = 0;
+    vid_t t;
+    weight_t w;
+    int present, exists;
+
+    while ( i < row->deg || j < nops ) {
+        if ( j == nops || (i < row->deg && row->edges[i].id < ops[j].dst) ) {
+            out[n++] = row->edges[i++];
+            continue;
+        }
+
+        // Apply, in order, all operations on edge (src, t)
+        t = ops[j].dst;
+        present = i < row->deg && row->edges[i].id == t;
+        exists = present;
+        w = present ? row->edges[i].weight : 0;
+        for ( ; j < nops && ops[j].dst == t; j++ ) {
+            switch ( ops[j].type ) {
+                case DYN_INSERT:
+                    if ( !exists && ops[j].src != t ) {
+                        exists = 1;
+                        w = ops[j].weight;
+                        stats->ninserted++;
+                    }
+                    break;
+                case DYN_DELETE:
+                    if ( exists ) {
+                        exists = 0;
+                        stats->ndeleted++;
+                    }
+                    break;
+                case DYN_UPDATE:
+                    if ( exists ) {
+                        w = ops[j].weight;
+                        stats->nupdated++;
+                    }
+                    break;
+            }
+        }
+        if ( present )
+            i++;
+        if ( exists ) {
+            out[n].id = t;
+            out[n].weight = w;
+            n++;
+        }
+    }
+
+    dyn_row_reserve(row, n);
+    memcpy(row->edges, out, n * sizeof(dyn_edge_t));
+    row->deg = n;
+}
+
+/**
+ * Applies the operations of a range, one source vertex at a time
+ */
+static void* dyn_apply_range(void *args)
+{
+    dyn_apply_targs_t *ta = (dyn_apply_targs_t*)args;
+    const dyn_op_t *ops = ta->ops;
+    eid_t b, e, need, scratch_size = 0;
+    dyn_edge_t *scratch = NULL;
+    dyn_row_t *row;
+
+    memset(&ta->stats, 0, sizeof(dyn_stats_t));
+
+    for ( b = ta->begin; b < ta->end; b = e ) {
+        for ( e = b + 1; e < ta->end && ops[e].src == ops[b].src; e++ )
+            ;
+        row = &ta->g->rows[ops[b].src];
+
+        need = row->deg + (e - b);
+        if ( need > scratch_size ) {
+            scratch_size = need * 2;
+            free(scratch);
+            scratch = (dyn_edge_t*)malloc_safe(scratch_size *
+                                               sizeof(dyn_edge_t));
+        }
+        dyn_merge_row(row, ops + b, e - b, scratch, &ta->stats);
+    }
+
+    free(scratch);
+
+    return NULL;
+}
+
+/**
+ * Applies a batch of operations; operations on the same edge take 
+ * effect in batch order. A directed batch already sorted by (src, dst),
+ * e.g. with dyngraph_sort_batch(), is applied in place; any other batch
+ * is sorted in a copy first. For undirected graphs every operation is 
+ * applied to both directions of the edge.
+ * Sources are split among threads, so that every row is updated by
+ * a single thread.
+ * @param g pointer to dynamic graph
+ * @param ops operations, on vertices of g
+ * @param nops number of operations
+ * @param stats effective operation counters (may be NULL)
+ * @param nthreads number of threads (<=0 for all online processors)
+ */
+void dyngraph_apply(dyngraph_t *g,
+                    dyn_op_t *ops,
+                    eid_t nops,
+                    dyn_stats_t *stats,
+                    int nthreads)
+{
+    int i;
+    eid_t k, pos;
+    dyn_op_t *all = ops;
+    dyn_apply_targs_t *targs;
+    dyn_stats_t total;
+    int sorted = 1;
+
+    for ( k = 0; k < nops; k++ ) {
+        if ( ops[k].src >= g->nvertices || ops[k].dst >= g->nvertices ) {
+            fprintf(stderr, "%s: Operation on missing vertex\n",
+                    __FUNCTION__);
+            exit(EXIT_FAILURE);
+        }
+        if ( k > 0 && dyn_op_less(&ops[k], &ops[k-1]) )
+            sorted = 0;
+    }
+
+    // Undirected graphs: interleave each operation with its mirror
+    // before sorting, so that both directions see the same order.
+    // The thread split below needs every source in one run.
+    if ( g->is_undirected ) {
+        all = (dyn_op_t*)malloc_safe(2 * nops * sizeof(dyn_op_t));
+        for ( k = 0; k < nops; k++ ) {
+            all[2*k] = ops[k];
+            all[2*k+1] = ops[k];
+            all[2*k+1].src = ops[k].dst;
+            all[2*k+1].dst = ops[k].src;
+        }
+        nops *= 2;
+        dyngraph_sort_batch(all, nops);
+    } else if ( !sorted ) {
+        all = (dyn_op_t*)malloc_safe(nops * sizeof(dyn_op_t));
+        memcpy(all, ops, nops * sizeof(dyn_op_t));
+        dyngraph_sort_batch(all, nops);
+    }
+
+    if ( nthreads <= 0 )
+        nthreads = parallel_default_nthreads();
+    targs = (dyn_apply_targs_t*)malloc_safe(nthreads *
+                                            sizeof(dyn_apply_targs_t));
+
+    // Split the batch in equal parts, moving every boundary forward
+    // to the next change of source
+    pos = 0;
+    for ( i = 0; i < nthreads; i++ ) {
+        targs[i].begin = pos;
+        pos = i == nthreads - 1 ? nops : nops * (i+1) / nthreads;
+        pos = pos > targs[i].begin ? pos : targs[i].begin;
+        while ( pos > 0 && pos < nops && all[pos].src == all[pos-1].src )
+            pos++;
+        targs[i].end = pos;
+        targs[i].ops = all;
+        targs[i].g = g;
+    }
+    parallel_run(dyn_apply_range, targs, sizeof(dyn_apply_targs_t), nthreads);
+
+    memset(&total, 0, sizeof(dyn_stats_t));
+    for ( i = 0; i < nthreads; i++ ) {
+        total.ninserted += targs[i].stats.ninserted;
+        total.ndeleted += targs[i].stats.ndeleted;
+        total.nupdated += targs[i].stats.nupdated;
+    }
+    g->nedges += total.ninserted;
+    g->nedges -= total.ndeleted;
+    if ( stats )
+        *stats = total;
+
+    free(targs);
+    if ( all != ops )
+        free(all);
+}
+
+/**
+ * Prints the dynamic graph
+ * @param g pointer to dynamic graph
+ */
+void dyngraph_print(dyngraph_t *g)
+{
+    vid_t v;
+    eid_t e;
+
+    for ( v = 0; v < g->nvertices; v++ ) {
+        fprintf(stdout, "Node %" PRIvid ": ", v);
+        for ( e = 0; e < g->rows[v].deg; e++ )
+            fprintf(stdout, "(%" PRIvid "->%" PRIvid ") [%.2f] ",
+                    v, g->rows[v].edges[e].id, g->rows[v].edges[e].weight);
+        fprintf(stdout, "\n");
+    }
+}
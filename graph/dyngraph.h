@@ -0,0 +1,91 @@
+/**
+ * @file
+ * Dynamic graph type definitions and function declarations.
+ *
+ * Every vertex owns a sorted array of (neighbor, weight) pairs with
+ * some slack at its end. Updates come in batches of operations sorted
+ * by source vertex; the rows touched by a batch are merged with their
+ * operations in parallel, each thread taking whole source vertices.
+ */
+
+#ifndef DYNGRAPH_H_
+#define DYNGRAPH_H_
+
+#include "csr.h"
+#include "graph.h"
+
+/**
+ * Neighbor entry
+ */
+typedef struct dyn_edge_st {
+    vid_t id; //!< neighbor id
+    weight_t weight; //!< edge weight
+} dyn_edge_t;
+
+/**
+ * Adjacency row of a vertex, sorted by neighbor id
+ */
+typedef struct dyn_row_st {
+    dyn_edge_t *edges; //!< neighbors
+    eid_t deg; //!< number of neighbors
+    eid_t cap; //!< allocated entries
+} dyn_row_t;
+
+/**
+ * Dynamic graph representation
+ */
+typedef struct dyngraph_st {
+    vid_t nvertices; //!< number of vertices
+    eid_t nedges; //!< number of (directed) edges
+    dyn_row_t *rows; //!< per-vertex rows
+    int is_undirected; //!< undirected flag
+} dyngraph_t;
+
+/**
+ * Update operation types
+ */
+enum { DYN_INSERT = 1, DYN_DELETE, DYN_UPDATE };
+
+/**
+ * Update operation. Inserting an existing edge, and deleting or
+ * updating a missing one, have no effect.
+ */
+typedef struct dyn_op_st {
+    vid_t src; //!< edge source
+    vid_t dst; //!< edge target
+    weight_t weight; //!< new weight (DYN_INSERT, DYN_UPDATE)
+    int type; //!< one of DYN_*
+} dyn_op_t;
+
+/**
+ * Number of operations that had an effect in a batch
+ */
+typedef struct dyn_stats_st {
+    eid_t ninserted;
+    eid_t ndeleted;
+    eid_t nupdated;
+} dyn_stats_t;
+
+/**
+ * Returns the out-degree of a vertex
+ * @param g pointer to dynamic graph
+ * @param v vertex id
+ * @return number of outgoing edges of v
+ */
+static inline eid_t dyngraph_degree(const dyngraph_t *g, vid_t v)
+{
+    return g->rows[v].deg;
+}
+
+extern dyngraph_t* dyngraph_create(vid_t nvertices, int is_undirected);
+extern dyngraph_t* csr_to_dyngraph(csr_t *g, int nthreads);
+extern void dyngraph_destroy(dyngraph_t *g);
+extern void dyngraph_sort_batch(dyn_op_t *ops, eid_t nops);
+extern void dyngraph_apply(dyngraph_t *g,
+                           dyn_op_t *ops,
+                           eid_t nops,
+                           dyn_stats_t *stats,
+                           int nthreads);
+extern void dyngraph_print(dyngraph_t *g);
+
+#endif
@@ -5,10 +5,17 @@
 
 #include "edgelist.h"
 
+#include <pthread.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "adjlist.h"
+#include "ccsr.h"
+#include "csr.h"
+#include "dyngraph.h"
+#include "parallel.h"
 
 /**
  * Create an edge list from an adjacency list
@@ -17,7 +24,8 @@
  */ 
 edgelist_t* edgelist_create(adjlist_t *al)
 {
-    unsigned int v, edge_count = 0;
+    vid_t v;
+    eid_t edge_count = 0;
     node_t *w;
     edgelist_t *el = (edgelist_t*)malloc(sizeof(edgelist_t));
     if ( !el ) {
@@ -67,6 +75,489 @@ edgelist_t* edgelist_create(adjlist_t *al)
     return el;
 }
 
+/**
+ * Create an edge list from a CSR graph
+ * @param g pointer to CSR graph
+ * @return pointer to created edge list
+ */ 
+edgelist_t* edgelist_create_csr(csr_t *g)
+{
+    vid_t v;
+    eid_t e, edge_count = 0;
+    edgelist_t *el = (edgelist_t*)malloc(sizeof(edgelist_t));
+    if ( !el ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+
+    el->nvertices = g->nvertices;
+    el->nedges = g->is_undirected ? (g->nedges/2) : (g->nedges) ;
+    el->is_undirected = g->is_undirected;
+    el->edge_array = (edge_t*)malloc(el->nedges * sizeof(edge_t));
+    if ( !el->edge_array ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+    
+    for ( v = 0; v < g->nvertices; v++ ) {
+        for ( e = g->offsets[v]; e < g->offsets[v+1]; e++ ) {
+
+            // Undirected graph: keep each edge (v,w) only when v<w, 
+            // as in edgelist_create()
+            if ( g->is_undirected && v >= g->neighbors[e] ) {
+                if ( v == g->neighbors[e] ) {
+                    fprintf(stderr, "Something bad happened." 
+                            "Self-edges should have been ignored. Exiting...\n");
+                    exit(EXIT_FAILURE);
+                }
+                continue;
+            }
+
+            el->edge_array[edge_count].vertex1 = v; 
+            el->edge_array[edge_count].vertex2 = g->neighbors[e]; 
+            el->edge_array[edge_count].weight = g->weights[e];
+            edge_count++;
+        }
+    }
+
+    return el;
+}
+
+/**
+ * Create an edge list from a compressed CSR graph, decoding the 
+ * neighbors of each vertex on the fly
+ * @param g pointer to compressed CSR graph
+ * @return pointer to created edge list
+ */ 
+edgelist_t* edgelist_create_ccsr(ccsr_t *g)
+{
+    vid_t v, w;
+    eid_t edge_count = 0;
+    weight_t weight;
+    ccsr_iter_t it;
+    edgelist_t *el = (edgelist_t*)malloc(sizeof(edgelist_t));
+    if ( !el ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+
+    el->nvertices = g->nvertices;
+    el->nedges = g->is_undirected ? (g->nedges/2) : (g->nedges) ;
+    el->is_undirected = g->is_undirected;
+    el->edge_array = (edge_t*)malloc(el->nedges * sizeof(edge_t));
+    if ( !el->edge_array ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+    
+    for ( v = 0; v < g->nvertices; v++ ) {
+        ccsr_iter_begin(g, v, &it);
+        while ( ccsr_iter_next(&it, &w, &weight) ) {
+
+            // Undirected graph: keep each edge (v,w) only when v<w, 
+            // as in edgelist_create()
+            if ( g->is_undirected && v >= w ) {
+                if ( v == w ) {
+                    fprintf(stderr, "Something bad happened." 
+                            "Self-edges should have been ignored. Exiting...\n");
+                    exit(EXIT_FAILURE);
+                }
+                continue;
+            }
+
+            el->edge_array[edge_count].vertex1 = v; 
+            el->edge_array[edge_count].vertex2 = w; 
+            el->edge_array[edge_count].weight = weight;
+            edge_count++;
+        }
+    }
+
+    return el;
+}
+
+/**
+ * Create an edge list from a dynamic graph. Edges of each vertex 
+ * come in increasing neighbor order.
+ * @param g pointer to dynamic graph
+ * @return pointer to created edge list
+ */ 
+edgelist_t* edgelist_create_dyn(dyngraph_t *g)
+{
+    vid_t v, w;
+    eid_t e, edge_count = 0;
+    dyn_row_t *row;
+    edgelist_t *el = (edgelist_t*)malloc(sizeof(edgelist_t));
+    if ( !el ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+
+    el->nvertices = g->nvertices;
+    el->nedges = g->is_undirected ? (g->nedges/2) : (g->nedges) ;
+    el->is_undirected = g->is_undirected;
+    el->edge_array = (edge_t*)malloc(el->nedges * sizeof(edge_t));
+    if ( !el->edge_array ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+    
+    for ( v = 0; v < g->nvertices; v++ ) {
+        row = &g->rows[v];
+        for ( e = 0; e < row->deg; e++ ) {
+            w = row->edges[e].id;
+
+            // Undirected graph: keep each edge (v,w) only when v<w, 
+            // as in edgelist_create()
+            if ( g->is_undirected && v >= w ) {
+                if ( v == w ) {
+                    fprintf(stderr, "Something bad happened." 
+                            "Self-edges should have been ignored. Exiting...\n");
+                    exit(EXIT_FAILURE);
+                }
+                continue;
+            }
+
+            el->edge_array[edge_count].vertex1 = v; 
+            el->edge_array[edge_count].vertex2 = w; 
+            el->edge_array[edge_count].weight = row->edges[e].weight;
+            edge_count++;
+        }
+    }
+
+    return el;
+}
+
+/**
+ * Per-thread state of the parallel edge list builders
+ */
+typedef struct {
+    vid_t vbegin, vend; //!< vertex range [vbegin,vend)
+    adjlist_t *al; //!< source adjacency list (or NULL)
+    csr_t *g; //!< source CSR graph (or NULL)
+    eid_t *counts; //!< per-vertex edge counts, then offsets
+    edgelist_t *el; //!< output edge list
+} edgelist_targs_t;
+
+/**
+ * Returns whether edge (v,w) goes to the edge list, exiting on 
+ * self-edges
+ */
+static inline int edgelist_keep(int is_undirected, 
+                                vid_t v, 
+                                vid_t w)
+{
+    if ( v == w ) {
+        fprintf(stderr, "Something bad happened." 
+                "Self-edges should have been ignored. Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Undirected graph: each edge (v,w) is added once, when v<w
+    return !is_undirected || v < w;
+}
+
+/**
+ * Counting phase: number of edge list entries of each vertex in range
+ */
+static void* edgelist_count(void *args)
+{
+    edgelist_targs_t *ta = (edgelist_targs_t*)args;
+    vid_t v;
+    eid_t e, n;
+    node_t *w;
+
+    for ( v = ta->vbegin; v < ta->vend; v++ ) {
+        n = 0;
+        if ( ta->al ) {
+            for ( w = ta->al->adj[v]; w != NULL; w = w->next ) 
+                n += edgelist_keep(ta->al->is_undirected, v, w->id);
+        } else {
+            for ( e = ta->g->offsets[v]; e < ta->g->offsets[v+1]; e++ ) 
+                n += edgelist_keep(ta->g->is_undirected, v, 
+                                   ta->g->neighbors[e]);
+        }
+        ta->counts[v+1] = n;
+    }
+
+    return NULL;
+}
+
+/**
+ * Fill phase: writes the edges of each vertex in range, starting at 
+ * the vertex offset
+ */
+static void* edgelist_fill(void *args)
+{
+    edgelist_targs_t *ta = (edgelist_targs_t*)args;
+    vid_t v;
+    eid_t e, i;
+    node_t *w;
+    edge_t *out = ta->el->edge_array;
+
+    for ( v = ta->vbegin; v < ta->vend; v++ ) {
+        i = ta->counts[v];
+        if ( ta->al ) {
+            for ( w = ta->al->adj[v]; w != NULL; w = w->next ) {
+                if ( ta->al->is_undirected && v > w->id )
+                    continue;
+                out[i].vertex1 = v;
+                out[i].vertex2 = w->id;
+                out[i].weight = w->weight;
+                i++;
+            }
+        } else {
+            for ( e = ta->g->offsets[v]; e < ta->g->offsets[v+1]; e++ ) {
+                if ( ta->g->is_undirected && v > ta->g->neighbors[e] )
+                    continue;
+                out[i].vertex1 = v;
+                out[i].vertex2 = ta->g->neighbors[e];
+                out[i].weight = ta->g->weights[e];
+                i++;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Parallel edge list construction, from either an adjacency list or 
+ * a CSR graph. Per-vertex edge counts are computed in parallel, an 
+ * exclusive prefix sum turns them into offsets, and edges are then 
+ * written in parallel at their vertex offset. The edge order is the 
+ * same as with the serial builders, for any number of threads.
+ */
+static edgelist_t* edgelist_create_parallel(adjlist_t *al, 
+                                            csr_t *g, 
+                                            int nthreads)
+{
+    vid_t v, nvertices = al ? al->nvertices : g->nvertices;
+    eid_t *counts;
+    int i;
+    edgelist_targs_t *targs;
+    edgelist_t *el = (edgelist_t*)malloc(sizeof(edgelist_t));
+    if ( !el ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+
+    if ( nthreads <= 0 )
+        nthreads = parallel_default_nthreads();
+
+    targs = (edgelist_targs_t*)malloc(nthreads * sizeof(edgelist_targs_t));
+    counts = (eid_t*)malloc((nvertices+1) * sizeof(eid_t));
+    if ( !targs || !counts ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+
+    el->nvertices = nvertices;
+    el->is_undirected = al ? al->is_undirected : g->is_undirected;
+
+    // Counting phase, on vertex ranges of equal size (or of similar 
+    // edge count for CSR graphs)
+    for ( i = 0; i < nthreads; i++ ) {
+        if ( g ) {
+            targs[i].vbegin = parallel_split_offsets(g->offsets, nvertices,
+                                                     nthreads, i);
+            targs[i].vend = parallel_split_offsets(g->offsets, nvertices,
+                                                   nthreads, i+1);
+        } else {
+            targs[i].vbegin = (eid_t)nvertices * i / nthreads;
+            targs[i].vend = (eid_t)nvertices * (i+1) / nthreads;
+        }
+        targs[i].al = al;
+        targs[i].g = g;
+        targs[i].counts = counts;
+        targs[i].el = el;
+    }
+    parallel_run(edgelist_count, targs, sizeof(edgelist_targs_t), nthreads);
+
+    // Exclusive prefix sum
+    counts[0] = 0;
+    for ( v = 0; v < nvertices; v++ )
+        counts[v+1] += counts[v];
+    el->nedges = counts[nvertices];
+
+    el->edge_array = (edge_t*)malloc(el->nedges * sizeof(edge_t));
+    if ( !el->edge_array ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+
+    // Fill phase, on vertex ranges with similar numbers of output edges
+    for ( i = 0; i < nthreads; i++ ) {
+        targs[i].vbegin = parallel_split_offsets(counts, nvertices, 
+                                                 nthreads, i);
+        targs[i].vend = parallel_split_offsets(counts, nvertices, 
+                                               nthreads, i+1);
+    }
+    parallel_run(edgelist_fill, targs, sizeof(edgelist_targs_t), nthreads);
+
+    free(counts);
+    free(targs);
+
+    return el;
+}
+
+/**
+ * Create an edge list from an adjacency list using multiple threads.
+ * The result is identical to that of edgelist_create().
+ * @param al pointer to adjacency list array
+ * @param nthreads number of threads (<=0 for all online processors)
+ * @return pointer to created edge list
+ */ 
+edgelist_t* edgelist_create_mt(adjlist_t *al, int nthreads)
+{
+    return edgelist_create_parallel(al, NULL, nthreads);
+}
+
+/**
+ * Create an edge list from a CSR graph using multiple threads.
+ * The result is identical to that of edgelist_create_csr().
+ * @param g pointer to CSR graph
+ * @param nthreads number of threads (<=0 for all online processors)
+ * @return pointer to created edge list
+ */ 
+edgelist_t* edgelist_create_csr_mt(csr_t *g, int nthreads)
+{
+    return edgelist_create_parallel(NULL, g, nthreads);
+}
+
+/**
+ * Bits of the weight key sorted per radix pass
+ */
+#define EDGELIST_RADIX_BITS 8
+#define EDGELIST_RADIX (1 << EDGELIST_RADIX_BITS)
+
+/**
+ * Fewest edges per sorting thread worth a thread
+ */
+#define EDGELIST_SORT_GRAIN 65536
+
+/**
+ * State shared by the sorting threads
+ */
+typedef struct {
+    edge_t *edges; //!< edges to sort
+    edge_t *tmp; //!< scratch copy, as large
+    eid_t nedges; //!< number of edges
+    int nthreads; //!< number of threads
+    eid_t (*counts)[EDGELIST_RADIX]; //!< per-thread digit counts
+    pthread_barrier_t barrier; //!< phase barrier
+} edgelist_sort_shared_t;
+
+/**
+ * Per-thread state of the sort
+ */
+typedef struct {
+    int id; //!< thread id
+    edgelist_sort_shared_t *sh; //!< shared state
+} edgelist_sort_targs_t;
+
+/**
+ * Sorting thread: LSD radix sort passes over the key, each one a 
+ * stable counting sort. Every thread counts the digits of its own 
+ * slice of edges, then scatters them after the same digits of the 
+ * slices before its own, so the order of equal keys never changes.
+ * Passes whose digit is the same for all edges are skipped.
+ */
+static void* edgelist_sort_thread(void *args)
+{
+    edgelist_sort_targs_t *ta = (edgelist_sort_targs_t*)args;
+    edgelist_sort_shared_t *sh = ta->sh;
+    eid_t begin = sh->nedges * ta->id / sh->nthreads;
+    eid_t end = sh->nedges * (ta->id + 1) / sh->nthreads;
+    eid_t e, total, base, offsets[EDGELIST_RADIX];
+    eid_t *counts = sh->counts[ta->id];
+    edge_t *src = sh->edges, *dst = sh->tmp, *t;
+    int shift, d, i, skip;
+
+    for ( shift = 0; shift < 32; shift += EDGELIST_RADIX_BITS ) {
+        memset(counts, 0, EDGELIST_RADIX * sizeof(eid_t));
+        for ( e = begin; e < end; e++ )
+            counts[(edgelist_weight_key(src[e].weight) >> shift) 
+                   & (EDGELIST_RADIX - 1)]++;
+        pthread_barrier_wait(&sh->barrier);
+
+        // Own offset of each digit: all smaller digits, then this digit
+        // in the slices before
+        base = 0;
+        skip = 0;
+        for ( d = 0; d < EDGELIST_RADIX; d++ ) {
+            offsets[d] = base;
+            total = 0;
+            for ( i = 0; i < sh->nthreads; i++ ) {
+                if ( i == ta->id )
+                    offsets[d] = base + total;
+                total += sh->counts[i][d];
+            }
+            skip |= total == sh->nedges;
+            base += total;
+        }
+
+        if ( !skip ) {
+            for ( e = begin; e < end; e++ )
+                dst[offsets[(edgelist_weight_key(src[e].weight) >> shift) 
+                            & (EDGELIST_RADIX - 1)]++] = src[e];
+            t = src;
+            src = dst;
+            dst = t;
+        }
+        pthread_barrier_wait(&sh->barrier);
+    }
+
+    // After an odd number of passes the result is in the scratch copy
+    if ( src != sh->edges )
+        memcpy(&sh->edges[begin], &src[begin], (end - begin) * sizeof(edge_t));
+
+    return NULL;
+}
+
+/**
+ * Sorts the edge list by non-decreasing weight with a parallel LSD 
+ * radix sort on the weight bit patterns. The sort is stable, so the 
+ * result does not depend on the number of threads.
+ * @param el pointer to edge list
+ * @param nthreads number of threads (<=0 for all online processors)
+ */ 
+void edgelist_sort(edgelist_t *el, int nthreads)
+{
+    edgelist_sort_shared_t sh;
+    edgelist_sort_targs_t *targs;
+    int i;
+
+    if ( nthreads <= 0 )
+        nthreads = parallel_default_nthreads();
+    if ( el->nedges < (eid_t)nthreads * EDGELIST_SORT_GRAIN )
+        nthreads = (int)(el->nedges / EDGELIST_SORT_GRAIN) + 1;
+
+    sh.edges = el->edge_array;
+    sh.nedges = el->nedges;
+    sh.nthreads = nthreads;
+    sh.tmp = (edge_t*)malloc((el->nedges ? el->nedges : 1) * sizeof(edge_t));
+    sh.counts = malloc(nthreads * sizeof(*sh.counts));
+    targs = (edgelist_sort_targs_t*)malloc(nthreads * 
+                                          sizeof(edgelist_sort_targs_t));
+    if ( !sh.tmp || !sh.counts || !targs ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+    pthread_barrier_init(&sh.barrier, NULL, nthreads);
+
+    for ( i = 0; i < nthreads; i++ ) {
+        targs[i].id = i;
+        targs[i].sh = &sh;
+    }
+    parallel_run(edgelist_sort_thread, targs, sizeof(edgelist_sort_targs_t), 
+                 nthreads);
+
+    pthread_barrier_destroy(&sh.barrier);
+    free(targs);
+    free(sh.counts);
+    free(sh.tmp);
+}
+
 /**
  * Destroys the edge list
  * @param el pointer to edge list
@@ -84,10 +575,10 @@ void edgelist_destroy(edgelist_t *el)
  */ 
 void edgelist_print(edgelist_t *el)
 {
-    unsigned int i;
+    eid_t i;
 
     for ( i = 0; i < el->nedges; i++ ) {
-        fprintf(stdout, "Edge %u: (%u,%u) [%.2f]\n", 
+        fprintf(stdout, "Edge %" PRIeid ": (%" PRIvid ",%" PRIvid ") [%.2f]\n", 
                 i, 
                 el->edge_array[i].vertex1,
                 el->edge_array[i].vertex2,
@@ -6,15 +6,21 @@
 #ifndef EDGELIST_H_
 #define EDGELIST_H_
 
+#include <stdint.h>
+#include <string.h>
+
 #include "adjlist.h"
+#include "ccsr.h"
+#include "csr.h"
+#include "dyngraph.h"
 #include "graph.h"
 
 /**
  * Graph edge 
  */
 typedef struct edge_st {
-    unsigned int vertex1; //!< edge's first vertex
-    unsigned int vertex2; //!< edge's second vertex
+    vid_t vertex1; //!< edge's first vertex
+    vid_t vertex2; //!< edge's second vertex
     weight_t weight; //!< edge weight
 } edge_t;
 
@@ -22,13 +28,33 @@ typedef struct edge_st {
  * Edge list graph representation
  */ 
 typedef struct edgelist_st {
-    unsigned int nvertices; //!< number of vertices
-    unsigned int nedges; //!< number of edges
+    vid_t nvertices; //!< number of vertices
+    eid_t nedges; //!< number of edges
     edge_t *edge_array; //!< array of edges
     int is_undirected; //!< undirected flag
 } edgelist_t;
 
+/**
+ * Maps a weight to an unsigned key in the same order: the sign bit is 
+ * flipped on non-negative floats, and all bits on negative ones, whose
+ * magnitude grows with their bit pattern. edgelist_sort() orders edges
+ * by this key, so -0 comes before +0.
+ */
+static inline uint32_t edgelist_weight_key(weight_t w)
+{
+    uint32_t k;
+
+    memcpy(&k, &w, sizeof(k));
+    return k & 0x80000000u ? ~k : k | 0x80000000u;
+}
+
 extern edgelist_t* edgelist_create(adjlist_t *al);
+extern edgelist_t* edgelist_create_csr(csr_t *g);
+extern edgelist_t* edgelist_create_ccsr(ccsr_t *g);
+extern edgelist_t* edgelist_create_dyn(dyngraph_t *g);
+extern edgelist_t* edgelist_create_mt(adjlist_t *al, int nthreads);
+extern edgelist_t* edgelist_create_csr_mt(csr_t *g, int nthreads);
+extern void edgelist_sort(edgelist_t *el, int nthreads);
 extern void edgelist_print(edgelist_t *el);
 extern void edgelist_destroy(edgelist_t *el);
 extern int edge_compare(const void *e1, const void *e2);
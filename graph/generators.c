@@ -0,0 +1,566 @@
+/**
+ * @file
+ * Synthetic graph generator function definitions
+ */
+
+#include "generators.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "parallel.h"
+#include "util/util.h"
+
+/**
+ * splitmix64 finalizer
+ */
+static inline uint64_t gen_mix(uint64_t z)
+{
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Returns the i-th random number of the stream of a seed
+ */
+static inline uint64_t gen_hash(uint64_t seed, uint64_t i)
+{
+    return gen_mix(gen_mix(seed + 0x9e3779b97f4a7c15ULL) +
+                   (i + 1) * 0x9e3779b97f4a7c15ULL);
+}
+
+/**
+ * Advances a splitmix64 state and returns the next random number
+ */
+static inline uint64_t gen_next(uint64_t *state)
+{
+    *state += 0x9e3779b97f4a7c15ULL;
+    return gen_mix(*state);
+}
+
+/**
+ * Maps a random number to a double in [0,1)
+ */
+static inline double gen_uniform(uint64_t r)
+{
+    return (double)(r >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * Maps a random number to an integer weight in [1,GEN_MAX_WEIGHT]
+ */
+static inline weight_t gen_weight(uint64_t r)
+{
+    return (weight_t)(1 + r % GEN_MAX_WEIGHT);
+}
+
+/**
+ * Allocates the arc arrays of a generated graph
+ */
+static dimacs_t* gen_alloc(vid_t nvertices, eid_t narcs)
+{
+    dimacs_t *d = (dimacs_t*)malloc_safe(sizeof(dimacs_t));
+
+    d->nvertices = nvertices;
+    d->nedges = narcs;
+    d->narcs = narcs;
+    d->src = (vid_t*)malloc_safe(narcs * sizeof(vid_t));
+    d->dst = (vid_t*)malloc_safe(narcs * sizeof(vid_t));
+    d->weight = (weight_t*)malloc_safe(narcs * sizeof(weight_t));
+
+    return d;
+}
+
+/**
+ * Per-vertex arc emitter. Returns the number of arcs of vertex v and,
+ * if d is not NULL, writes them at position pos of d.
+ */
+typedef eid_t (*gen_vertex_fn)(const void *ctx,
+                               vid_t v,
+                               dimacs_t *d,
+                               eid_t pos);
+
+/**
+ * Per-thread state of per-vertex generators
+ */
+typedef struct {
+    vid_t vbegin, vend; //!< vertex range [vbegin,vend)
+    gen_vertex_fn fn; //!< arc emitter
+    const void *ctx; //!< emitter context
+    eid_t narcs; //!< number of arcs of the range
+    eid_t offset; //!< position of the first arc of the range
+    dimacs_t *d; //!< output arcs
+} gen_targs_t;
+
+/**
+ * First pass: counts the arcs of a vertex range
+ */
+static void* gen_vertices_count(void *args)
+{
+    gen_targs_t *ta = (gen_targs_t*)args;
+    vid_t v;
+
+    ta->narcs = 0;
+    for ( v = ta->vbegin; v < ta->vend; v++ )
+        ta->narcs += ta->fn(ta->ctx, v, NULL, 0);
+
+    return NULL;
+}
+
+/**
+ * Second pass: writes the arcs of a vertex range
+ */
+static void* gen_vertices_fill(void *args)
+{
+    gen_targs_t *ta = (gen_targs_t*)args;
+    vid_t v;
+    eid_t pos = ta->offset;
+
+    for ( v = ta->vbegin; v < ta->vend; v++ )
+        pos += ta->fn(ta->ctx, v, ta->d, pos);
+
+    return NULL;
+}
+
+/**
+ * Generates a graph vertex by vertex: the arcs of each vertex range are
+ * counted in parallel, an exclusive prefix sum gives the output
+ * position of each range, and the arcs are then written in parallel.
+ * Arcs come out ordered by vertex, whatever the number of threads.
+ */
+static dimacs_t* gen_vertices(vid_t nvertices,
+                              gen_vertex_fn fn,
+                              const void *ctx,
+                              int nthreads)
+{
+    int i;
+    eid_t total;
+    gen_targs_t *targs;
+    dimacs_t *d;
+
+    if ( nthreads <= 0 )
+        nthreads = parallel_default_nthreads();
+
+    targs = (gen_targs_t*)malloc_safe(nthreads * sizeof(gen_targs_t));
+    for ( i = 0; i < nthreads; i++ ) {
+        targs[i].vbegin = (eid_t)nvertices * i / nthreads;
+        targs[i].vend = (eid_t)nvertices * (i+1) / nthreads;
+        targs[i].fn = fn;
+        targs[i].ctx = ctx;
+    }
+    parallel_run(gen_vertices_count, targs, sizeof(gen_targs_t), nthreads);
+
+    total = 0;
+    for ( i = 0; i < nthreads; i++ ) {
+        targs[i].offset = total;
+        total += targs[i].narcs;
+    }
+
+    d = gen_alloc(nvertices, total);
+    for ( i = 0; i < nthreads; i++ )
+        targs[i].d = d;
+    parallel_run(gen_vertices_fill, targs, sizeof(gen_targs_t), nthreads);
+
+    free(targs);
+
+    return d;
+}
+
+/**
+ * R-MAT generator state
+ */
+typedef struct {
+    int scale; //!< log2 of the number of vertices
+    double a, ab, abc; //!< cumulative quadrant probabilities
+    uint64_t seed; //!< random seed
+    eid_t begin, end; //!< arc range [begin,end)
+    dimacs_t *d; //!< output arcs
+} gen_rmat_targs_t;
+
+/**
+ * Relabels R-MAT vertices with a seeded bijection of [0,2^scale), so
+ * that high-degree vertices are not all packed at low ids
+ */
+static inline uint64_t gen_scramble(uint64_t v, int scale, uint64_t seed)
+{
+    uint64_t mask = scale >= 64 ? ~0ULL : (1ULL << scale) - 1;
+
+    v = (v * 0x9e3779b97f4a7c15ULL) & mask;
+    v ^= v >> ((scale + 1) / 2);
+    v = (v * 0xbf58476d1ce4e5b9ULL) & mask;
+    v ^= gen_mix(seed) & mask;
+
+    return v;
+}
+
+/**
+ * Generates a range of R-MAT arcs
+ */
+static void* gen_rmat_range(void *args)
+{
+    gen_rmat_targs_t *ta = (gen_rmat_targs_t*)args;
+    uint64_t state, u, v;
+    double r;
+    eid_t i;
+    int l;
+
+    for ( i = ta->begin; i < ta->end; i++ ) {
+        // Each arc has its own random stream; self-loops are redrawn
+        state = gen_hash(ta->seed, i);
+        do {
+            u = v = 0;
+            for ( l = 0; l < ta->scale; l++ ) {
+                r = gen_uniform(gen_next(&state));
+                u <<= 1;
+                v <<= 1;
+                if ( r < ta->a )
+                    continue;
+                else if ( r < ta->ab )
+                    v |= 1;
+                else if ( r < ta->abc )
+                    u |= 1;
+                else {
+                    u |= 1;
+                    v |= 1;
+                }
+            }
+        } while ( u == v );
+
+        ta->d->src[i] = (vid_t)gen_scramble(u, ta->scale, ta->seed);
+        ta->d->dst[i] = (vid_t)gen_scramble(v, ta->scale, ta->seed);
+        ta->d->weight[i] = gen_weight(gen_next(&state));
+    }
+
+    return NULL;
+}
+
+/**
+ * Generates an R-MAT (recursive matrix / Kronecker) graph. Every arc
+ * picks one quadrant of the adjacency matrix per level, with
+ * probabilities a, b, c and 1-a-b-c. Self-loops are redrawn; parallel
+ * arcs are kept (they are removed when the graph is built).
+ * @param scale log2 of the number of vertices (>= 1)
+ * @param narcs number of directed arcs
+ * @param a upper-left quadrant probability
+ * @param b upper-right quadrant probability
+ * @param c lower-left quadrant probability
+ * @param seed random seed
+ * @param nthreads number of threads (<=0 for all online processors)
+ * @return pointer to generated arcs
+ */
+dimacs_t* gen_rmat(int scale,
+                   eid_t narcs,
+                   double a,
+                   double b,
+                   double c,
+                   uint64_t seed,
+                   int nthreads)
+{
+    int i;
+    gen_rmat_targs_t *targs;
+    dimacs_t *d;
+
+    if ( scale < 1 || scale >= (int)(8 * sizeof(vid_t)) ) {
+        fprintf(stderr, "%s: Unsupported scale %d\n", __FUNCTION__, scale);
+        exit(EXIT_FAILURE);
+    }
+
+    d = gen_alloc((vid_t)1 << scale, narcs);
+
+    if ( nthreads <= 0 )
+        nthreads = parallel_default_nthreads();
+    targs = (gen_rmat_targs_t*)malloc_safe(nthreads *
+                                           sizeof(gen_rmat_targs_t));
+    for ( i = 0; i < nthreads; i++ ) {
+        targs[i].scale = scale;
+        targs[i].a = a;
+        targs[i].ab = a + b;
+        targs[i].abc = a + b + c;
+        targs[i].seed = seed;
+        targs[i].begin = narcs * i / nthreads;
+        targs[i].end = narcs * (i+1) / nthreads;
+        targs[i].d = d;
+    }
+    parallel_run(gen_rmat_range, targs, sizeof(gen_rmat_targs_t), nthreads);
+    free(targs);
+
+    return d;
+}
+
+/**
+ * Grid generator context
+ */
+typedef struct {
+    vid_t nx, ny, nz; //!< grid dimensions
+    uint64_t seed; //!< random seed
+} gen_grid_ctx_t;
+
+/**
+ * Emits the arcs of a grid vertex towards its +x, +y and +z neighbors
+ */
+static eid_t gen_grid_vertex(const void *ctx, vid_t v, dimacs_t *d, eid_t pos)
+{
+    const gen_grid_ctx_t *c = (const gen_grid_ctx_t*)ctx;
+    vid_t x = v % c->nx, y = (v / c->nx) % c->ny, z = v / c->nx / c->ny;
+    vid_t nbr[3];
+    eid_t n = 0, k;
+
+    if ( x + 1 < c->nx )
+        nbr[n++] = v + 1;
+    if ( y + 1 < c->ny )
+        nbr[n++] = v + c->nx;
+    if ( z + 1 < c->nz )
+        nbr[n++] = v + c->nx * c->ny;
+
+    if ( d ) {
+        for ( k = 0; k < n; k++ ) {
+            d->src[pos+k] = v;
+            d->dst[pos+k] = nbr[k];
+            d->weight[pos+k] = gen_weight(gen_hash(c->seed,
+                                                   (eid_t)v * 3 + k));
+        }
+    }
+
+    return n;
+}
+
+/**
+ * Generates a 2D (nz = 1) or 3D grid with random integer weights. Each
+ * edge is generated once, so the graph should be built as undirected.
+ * @param nx grid size along x
+ * @param ny grid size along y
+ * @param nz grid size along z (1 for a 2D grid)
+ * @param seed random seed
+ * @param nthreads number of threads (<=0 for all online processors)
+ * @return pointer to generated arcs
+ */
+dimacs_t* gen_grid(vid_t nx,
+                   vid_t ny,
+                   vid_t nz,
+                   uint64_t seed,
+                   int nthreads)
+{
+    gen_grid_ctx_t c;
+
+    if ( nx == 0 || ny == 0 || nz == 0 ||
+         (double)nx * ny * nz > (double)VID_MAX ) {
+        fprintf(stderr, "%s: Unsupported grid size\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+
+    c.nx = nx;
+    c.ny = ny;
+    c.nz = nz;
+    c.seed = seed;
+
+    return gen_vertices(nx * ny * nz, gen_grid_vertex, &c, nthreads);
+}
+
+/**
+ * Random geometric graph generator context. Points are bucketed in a
+ * grid of ncells x ncells square cells of side at least the radius,
+ * so that the neighbors of a point lie in its own or adjacent cells.
+ */
+typedef struct {
+    double *x, *y; //!< point coordinates
+    double radius; //!< connection radius
+    vid_t ncells; //!< number of cells per side
+    eid_t *cell_start; //!< first position of each cell in cell_points
+    vid_t *cell_points; //!< point ids, grouped by cell and sorted
+} gen_geo_ctx_t;
+
+/**
+ * Returns the cell coordinate of a point coordinate
+ */
+static inline vid_t gen_geo_cell(const gen_geo_ctx_t *c, double x)
+{
+    vid_t i = (vid_t)(x * c->ncells);
+    return i < c->ncells ? i : c->ncells - 1;
+}
+
+/**
+ * Emits the edges of a point towards the points of higher id within
+ * the radius, scanning the adjacent cells in a fixed order
+ */
+static eid_t gen_geo_vertex(const void *ctx, vid_t v, dimacs_t *d, eid_t pos)
+{
+    const gen_geo_ctx_t *c = (const gen_geo_ctx_t*)ctx;
+    vid_t cx = gen_geo_cell(c, c->x[v]), cy = gen_geo_cell(c, c->y[v]);
+    vid_t i, j, w;
+    eid_t e, n = 0;
+    double dx, dy, r2 = c->radius * c->radius;
+
+    for ( j = cy > 0 ? cy - 1 : 0; j <= cy + 1 && j < c->ncells; j++ ) {
+        for ( i = cx > 0 ? cx - 1 : 0; i <= cx + 1 && i < c->ncells; i++ ) {
+            for ( e = c->cell_start[j * c->ncells + i];
+                  e < c->cell_start[j * c->ncells + i + 1]; e++ ) {
+                w = c->cell_points[e];
+                if ( w <= v )
+                    continue;
+                dx = c->x[w] - c->x[v];
+                dy = c->y[w] - c->y[v];
+                if ( dx * dx + dy * dy > r2 )
+                    continue;
+                if ( d ) {
+                    d->src[pos+n] = v;
+                    d->dst[pos+n] = w;
+                    d->weight[pos+n] = (weight_t)sqrt(dx * dx + dy * dy);
+                }
+                n++;
+            }
+        }
+    }
+
+    return n;
+}
+
+/**
+ * Generates a random geometric graph: n points uniformly distributed in
+ * the unit square, with an edge between every two points closer than
+ * a radius chosen to give the requested average degree. Edge weights
+ * are Euclidean distances. Each edge is generated once, so the graph
+ * should be built as undirected.
+ * @param n number of vertices
+ * @param avg_degree expected average degree
+ * @param seed random seed
+ * @param nthreads number of threads (<=0 for all online processors)
+ * @return pointer to generated arcs
+ */
+dimacs_t* gen_geometric(vid_t n,
+                        double avg_degree,
+                        uint64_t seed,
+                        int nthreads)
+{
+    vid_t v, cell, ncells2;
+    gen_geo_ctx_t c;
+    dimacs_t *d;
+
+    c.radius = sqrt(avg_degree / (M_PI * (n > 0 ? n : 1)));
+    c.ncells = c.radius > 0 ? (vid_t)(1.0 / c.radius) : 1;
+    if ( (double)c.ncells * c.ncells > n )
+        c.ncells = (vid_t)sqrt((double)n);
+    if ( c.ncells < 1 )
+        c.ncells = 1;
+    ncells2 = c.ncells * c.ncells;
+
+    c.x = (double*)malloc_safe(n * sizeof(double));
+    c.y = (double*)malloc_safe(n * sizeof(double));
+    for ( v = 0; v < n; v++ ) {
+        c.x[v] = gen_uniform(gen_hash(seed, 2 * (eid_t)v));
+        c.y[v] = gen_uniform(gen_hash(seed, 2 * (eid_t)v + 1));
+    }
+
+    // Counting sort of the points by cell (stable, so each cell holds
+    // increasing ids)
+    c.cell_start = (eid_t*)malloc_safe((ncells2 + 2) * sizeof(eid_t));
+    c.cell_points = (vid_t*)malloc_safe(n * sizeof(vid_t));
+    for ( cell = 0; cell < ncells2 + 2; cell++ )
+        c.cell_start[cell] = 0;
+    for ( v = 0; v < n; v++ )
+        c.cell_start[gen_geo_cell(&c, c.y[v]) * c.ncells +
+                     gen_geo_cell(&c, c.x[v]) + 2]++;
+    for ( cell = 0; cell < ncells2; cell++ )
+        c.cell_start[cell+2] += c.cell_start[cell+1];
+    for ( v = 0; v < n; v++ )
+        c.cell_points[c.cell_start[gen_geo_cell(&c, c.y[v]) * c.ncells +
+                                   gen_geo_cell(&c, c.x[v]) + 1]++] = v;
+
+    d = gen_vertices(n, gen_geo_vertex, &c, nthreads);
+
+    free(c.x);
+    free(c.y);
+    free(c.cell_start);
+    free(c.cell_points);
+
+    return d;
+}
+
+/**
+ * Checks whether a graph name is a generator specification
+ * @param spec graph file name or generator specification
+ * @return 1 for generator specifications, 0 otherwise
+ */
+int gen_is_spec(const char *spec)
+{
+    return strncmp(spec, "rmat:", 5) == 0 ||
+           strncmp(spec, "grid2d:", 7) == 0 ||
+           strncmp(spec, "grid3d:", 7) == 0 ||
+           strncmp(spec, "geo:", 4) == 0;
+}
+
+/**
+ * Checks that the first n values of a specification fit in a vertex id
+ */
+static int gen_spec_fits_vid(const unsigned long long *p, int n)
+{
+    int i;
+
+    for ( i = 0; i < n; i++ )
+        if ( p[i] > VID_MAX )
+            return 0;
+    return 1;
+}
+
+/**
+ * Generates a graph from a specification (see generators.h)
+ * @param spec generator specification
+ * @param is_undirected set to 1 if the graph should be built as
+ *                      undirected, 0 otherwise
+ * @param nthreads number of threads (<=0 for all online processors)
+ * @return pointer to generated arcs
+ */
+dimacs_t* gen_from_spec(const char *spec, int *is_undirected, int nthreads)
+{
+    unsigned long long p[4] = { 0, 0, 0, 0 };
+    double deg = 0.0;
+    uint64_t seed = 1;
+    int n;
+
+    if ( strncmp(spec, "rmat:", 5) == 0 ) {
+        n = sscanf(spec + 5, "%llu:%llu:%llu", &p[0], &p[1], &p[2]);
+        // The scale must fit in a vertex id, and the arc count in an 
+        // edge count
+        if ( n >= 2 && p[0] >= 1 && p[0] < 8 * sizeof(vid_t) &&
+             p[1] <= EID_MAX >> p[0] ) {
+            if ( n == 3 )
+                seed = p[2];
+            *is_undirected = 0;
+            return gen_rmat((int)p[0], (eid_t)p[1] << p[0],
+                            GEN_RMAT_A, GEN_RMAT_B, GEN_RMAT_C,
+                            seed, nthreads);
+        }
+    } else if ( strncmp(spec, "grid2d:", 7) == 0 ) {
+        n = sscanf(spec + 7, "%llu:%llu:%llu", &p[0], &p[1], &p[2]);
+        if ( n >= 2 && gen_spec_fits_vid(p, 2) ) {
+            if ( n == 3 )
+                seed = p[2];
+            *is_undirected = 1;
+            return gen_grid(p[0], p[1], 1, seed, nthreads);
+        }
+    } else if ( strncmp(spec, "grid3d:", 7) == 0 ) {
+        n = sscanf(spec + 7, "%llu:%llu:%llu:%llu",
+                   &p[0], &p[1], &p[2], &p[3]);
+        if ( n >= 3 && gen_spec_fits_vid(p, 3) ) {
+            if ( n == 4 )
+                seed = p[3];
+            *is_undirected = 1;
+            return gen_grid(p[0], p[1], p[2], seed, nthreads);
+        }
+    } else if ( strncmp(spec, "geo:", 4) == 0 ) {
+        n = sscanf(spec + 4, "%llu:%lf:%llu", &p[0], &deg, &p[1]);
+        if ( n >= 2 && gen_spec_fits_vid(p, 1) && isfinite(deg) && 
+             deg > 0 ) {
+            if ( n == 3 )
+                seed = p[1];
+            *is_undirected = 1;
+            return gen_geometric(p[0], deg, seed, nthreads);
+        }
+    }
+
+    fprintf(stderr, "%s: Invalid generator specification %s\n",
+            __FUNCTION__, spec);
+    exit(EXIT_FAILURE);
+}
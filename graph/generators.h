@@ -0,0 +1,62 @@
+/**
+ * @file
+ * Synthetic graph generator function declarations.
+ *
+ * Generators produce the arcs of a graph in memory, in the same form as
+ * dimacs_read(), so that the graph can be built with csr_build() or
+ * adjlist_build() without going through a file. All random choices
+ * are drawn from a counter-based generator indexed by the seed and the
+ * arc (or vertex) number, so the output is the same for any number
+ * of threads.
+ *
+ * Generator specifications, accepted wherever a graph file name is:
+ *   rmat:<scale>:<edgefactor>[:<seed>]    R-MAT, 2^scale vertices,
+ *                                         edgefactor*2^scale directed arcs
+ *   grid2d:<nx>:<ny>[:<seed>]             2D grid, undirected
+ *   grid3d:<nx>:<ny>:<nz>[:<seed>]        3D grid, undirected
+ *   geo:<n>:<avgdegree>[:<seed>]          random geometric graph in the
+ *                                         unit square, undirected
+ */
+
+#ifndef GENERATORS_H_
+#define GENERATORS_H_
+
+#include <stdint.h>
+
+#include "dimacs.h"
+#include "graph.h"
+
+/**
+ * Grid and R-MAT edge weights are integers in [1,GEN_MAX_WEIGHT]
+ */
+#define GEN_MAX_WEIGHT 100
+
+/**
+ * R-MAT quadrant probabilities (Graph500 defaults; d = 1-a-b-c)
+ */
+#define GEN_RMAT_A 0.57
+#define GEN_RMAT_B 0.19
+#define GEN_RMAT_C 0.19
+
+extern dimacs_t* gen_rmat(int scale,
+                          eid_t narcs,
+                          double a,
+                          double b,
+                          double c,
+                          uint64_t seed,
+                          int nthreads);
+extern dimacs_t* gen_grid(vid_t nx,
+                          vid_t ny,
+                          vid_t nz,
+                          uint64_t seed,
+                          int nthreads);
+extern dimacs_t* gen_geometric(vid_t n,
+                               double avg_degree,
+                               uint64_t seed,
+                               int nthreads);
+extern int gen_is_spec(const char *spec);
+extern dimacs_t* gen_from_spec(const char *spec,
+                               int *is_undirected,
+                               int nthreads);
+
+#endif
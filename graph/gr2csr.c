@@ -0,0 +1,35 @@
+/**
+ * @file
+ * Converts a graph file in "coord" format to a binary CSR snapshot
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "adjlist.h"
+#include "csr.h"
+#include "csr_file.h"
+
+int main(int argc, char **argv)
+{
+    adjlist_stats_t stats;
+    csr_t *g;
+
+    if ( argc < 4 ) {
+        fprintf(stderr, "Usage: %s <graphfile.gr> <snapshot> "
+                        "<is_undirected>\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    adjlist_init_stats(&stats);
+    g = csr_read(argv[1], &stats, atoi(argv[3]));
+    csr_write_binary(g, argv[2]);
+
+    fprintf(stdout, "Wrote %s: %" PRIvid " vertices, %" PRIeid " edges (%s)\n",
+            argv[2], g->nvertices, g->nedges,
+            g->is_undirected ? "undirected" : "directed");
+
+    csr_destroy(g);
+
+    return 0;
+}
@@ -6,9 +6,32 @@
 #ifndef GRAPH_H_
 #define GRAPH_H_
 
+#include <inttypes.h>
 #include <limits.h>
+#include <stdint.h>
 #define INFINITY FLT_MAX
 
 typedef float weight_t;
 
+/**
+ * Vertex and edge index types. By default vertex ids are 32-bit and
+ * edge counts/offsets 64-bit, so that graphs with more than 4G edges
+ * can be loaded while per-vertex structures (heaps, predecessor
+ * arrays, edge endpoints) stay small. Compiling with -DGRAPH_64BIT_IDS
+ * makes vertex ids 64-bit as well.
+ */
+#ifdef GRAPH_64BIT_IDS
+typedef uint64_t vid_t; //!< vertex id / vertex count
+#define PRIvid PRIu64
+#define VID_MAX UINT64_MAX
+#else
+typedef uint32_t vid_t;
+#define PRIvid PRIu32
+#define VID_MAX UINT32_MAX
+#endif
+
+typedef uint64_t eid_t; //!< edge index / edge count
+#define PRIeid PRIu64
+#define EID_MAX UINT64_MAX
+
 #endif
@@ -0,0 +1,97 @@
+/**
+ * @file
+ * Thread helper function definitions
+ */
+
+#include "parallel.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * Returns the number of online processors
+ */
+int parallel_default_nthreads(void)
+{
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+/**
+ * Runs fn on nthreads threads and waits for all of them. Thread i gets
+ * a pointer to the i-th element of the targs array. With a single 
+ * thread, fn is called directly.
+ * @param fn thread function
+ * @param targs array of per-thread arguments
+ * @param targ_size size of each element of targs
+ * @param nthreads number of threads
+ */
+void parallel_run(void *(*fn)(void*), 
+                  void *targs, 
+                  size_t targ_size, 
+                  int nthreads)
+{
+    pthread_t *tids;
+    int i;
+
+    if ( nthreads == 1 ) {
+        fn(targs);
+        return;
+    }
+
+    tids = (pthread_t*)malloc(nthreads * sizeof(pthread_t));
+    if ( !tids ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+
+    for ( i = 0; i < nthreads; i++ ) {
+        if ( pthread_create(&tids[i], NULL, fn, 
+                            (char*)targs + i * targ_size) != 0 ) {
+            fprintf(stderr, "%s: Thread creation error\n", __FUNCTION__);
+            exit(EXIT_FAILURE);
+        }
+    }
+    for ( i = 0; i < nthreads; i++ )
+        pthread_join(tids[i], NULL);
+
+    free(tids);
+}
+
+/**
+ * Splits the vertex range [0,n) into nthreads parts holding about the 
+ * same number of edges, given CSR-like offsets (n+1 entries).
+ * @param offsets per-vertex edge offsets
+ * @param n number of vertices
+ * @param nthreads number of parts
+ * @param i part index, 0 <= i <= nthreads
+ * @return first vertex of part i (n for i == nthreads)
+ */
+vid_t parallel_split_offsets(const eid_t *offsets,
+                             vid_t n,
+                             int nthreads,
+                             int i)
+{
+    vid_t lo = 0, hi = n, mid;
+    eid_t target;
+
+    if ( i <= 0 )
+        return 0;
+    if ( i >= nthreads )
+        return n;
+
+    target = offsets[n] * i / nthreads;
+
+    // First vertex whose row starts at or after the target edge
+    while ( lo < hi ) {
+        mid = lo + (hi - lo) / 2;
+        if ( offsets[mid] < target )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
@@ -0,0 +1,23 @@
+/**
+ * @file
+ * Thread helper function declarations
+ */
+
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include <stddef.h>
+
+#include "graph.h"
+
+extern int parallel_default_nthreads(void);
+extern void parallel_run(void *(*fn)(void*), 
+                         void *targs, 
+                         size_t targ_size, 
+                         int nthreads);
+extern vid_t parallel_split_offsets(const eid_t *offsets,
+                                    vid_t n,
+                                    int nthreads,
+                                    int i);
+
+#endif
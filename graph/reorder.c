@@ -0,0 +1,307 @@
+/**
+ * @file
+ * Vertex reordering function definitions.
+ *
+ * A reordering relabels the vertices of a CSR graph so that vertices
+ * visited close together in time get close ids, and therefore per-vertex
+ * arrays (distances, predecessors, heap positions, forest nodes) are
+ * accessed with better locality. The relabeled graph is built by
+ * csr_permute(); results computed on it are translated back to the
+ * original ids through the inverse mapping.
+ */
+
+#include "reorder.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "parallel.h"
+#include "util/util.h"
+
+/**
+ * Vertex sort key: (degree, id)
+ */
+typedef struct {
+    eid_t deg;
+    vid_t v;
+} reorder_key_t;
+
+/**
+ * Compares two keys by ascending degree, then ascending id
+ */
+static int reorder_key_compare(const void *k1, const void *k2)
+{
+    const reorder_key_t *a = (const reorder_key_t*)k1,
+                        *b = (const reorder_key_t*)k2;
+
+    if ( a->deg != b->deg )
+        return a->deg < b->deg ? -1 : 1;
+    return a->v < b->v ? -1 : (a->v > b->v);
+}
+
+/**
+ * Parses an ordering name ("none", "rcm", "degree", "bfs")
+ * @param name ordering name
+ * @return ordering, exits on unknown names
+ */
+reorder_method_t reorder_parse(const char *name)
+{
+    if ( strcmp(name, "none") == 0 )
+        return REORDER_NONE;
+    if ( strcmp(name, "rcm") == 0 )
+        return REORDER_RCM;
+    if ( strcmp(name, "degree") == 0 )
+        return REORDER_DEGREE;
+    if ( strcmp(name, "bfs") == 0 )
+        return REORDER_BFS;
+
+    fprintf(stderr, "%s: Unknown ordering %s\n", __FUNCTION__, name);
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * Sorts vertices by descending out-degree (counting sort, stable in
+ * the original ids)
+ */
+static void reorder_degree(csr_t *g, vid_t *order)
+{
+    vid_t v;
+    eid_t d, maxdeg = 0, *counts;
+
+    for ( v = 0; v < g->nvertices; v++ ) {
+        d = csr_degree(g, v);
+        maxdeg = d > maxdeg ? d : maxdeg;
+    }
+
+    // counts[maxdeg-d] holds the first position of degree d
+    counts = (eid_t*)malloc_safe((maxdeg+2) * sizeof(eid_t));
+    for ( d = 0; d < maxdeg+2; d++ )
+        counts[d] = 0;
+    for ( v = 0; v < g->nvertices; v++ )
+        counts[maxdeg - csr_degree(g, v) + 1]++;
+    for ( d = 0; d < maxdeg; d++ )
+        counts[d+1] += counts[d];
+    for ( v = 0; v < g->nvertices; v++ )
+        order[counts[maxdeg - csr_degree(g, v)]++] = v;
+
+    free(counts);
+}
+
+/**
+ * Visits the graph breadth-first, appending vertices to order[].
+ * Every connected component (through out-edges) is visited from a
+ * start vertex: the next unvisited vertex in id order for plain BFS,
+ * the unvisited vertex of minimum degree for Cuthill-McKee. With
+ * Cuthill-McKee, the unvisited neighbors of every vertex are also
+ * appended by ascending degree.
+ */
+static void reorder_bfs(csr_t *g, vid_t *order, int cuthill_mckee)
+{
+    vid_t v, w, head, tail, next_start;
+    eid_t e, k, n;
+    char *visited;
+    vid_t *starts = NULL;
+    reorder_key_t *keys = NULL;
+
+    visited = (char*)malloc_safe(g->nvertices * sizeof(char));
+    memset(visited, 0, g->nvertices * sizeof(char));
+
+    if ( cuthill_mckee ) {
+        // Candidate start vertices, by ascending degree
+        keys = (reorder_key_t*)malloc_safe(g->nvertices *
+                                           sizeof(reorder_key_t));
+        for ( v = 0; v < g->nvertices; v++ ) {
+            keys[v].deg = csr_degree(g, v);
+            keys[v].v = v;
+        }
+        qsort(keys, g->nvertices, sizeof(reorder_key_t),
+              reorder_key_compare);
+        starts = (vid_t*)malloc_safe(g->nvertices * sizeof(vid_t));
+        for ( v = 0; v < g->nvertices; v++ )
+            starts[v] = keys[v].v;
+    }
+
+    head = tail = 0;
+    next_start = 0;
+    while ( tail < g->nvertices ) {
+        // Start a new component
+        if ( head == tail ) {
+            while ( visited[starts ? starts[next_start] : next_start] )
+                next_start++;
+            v = starts ? starts[next_start] : next_start;
+            visited[v] = 1;
+            order[tail++] = v;
+        }
+
+        v = order[head++];
+        n = 0;
+        for ( e = g->offsets[v]; e < g->offsets[v+1]; e++ ) {
+            w = g->neighbors[e];
+            if ( visited[w] )
+                continue;
+            visited[w] = 1;
+            if ( cuthill_mckee ) {
+                keys[n].deg = csr_degree(g, w);
+                keys[n].v = w;
+                n++;
+            } else {
+                order[tail++] = w;
+            }
+        }
+        if ( cuthill_mckee ) {
+            qsort(keys, n, sizeof(reorder_key_t), reorder_key_compare);
+            for ( k = 0; k < n; k++ )
+                order[tail++] = keys[k].v;
+        }
+    }
+
+    free(visited);
+    free(starts);
+    free(keys);
+}
+
+/**
+ * Computes a vertex relabeling of a CSR graph
+ * @param g pointer to CSR graph
+ * @param method ordering
+ * @return pointer to relabeling (perm and inverse)
+ */
+reorder_t* reorder_compute(csr_t *g, reorder_method_t method)
+{
+    vid_t v, tmp;
+    reorder_t *r = (reorder_t*)malloc_safe(sizeof(reorder_t));
+
+    r->nvertices = g->nvertices;
+    r->perm = (vid_t*)malloc_safe(g->nvertices * sizeof(vid_t));
+    r->inv = (vid_t*)malloc_safe(g->nvertices * sizeof(vid_t));
+
+    // Compute the new vertex order in inv[]
+    switch ( method ) {
+        case REORDER_RCM:
+            reorder_bfs(g, r->inv, 1);
+            for ( v = 0; v < g->nvertices / 2; v++ ) {
+                tmp = r->inv[v];
+                r->inv[v] = r->inv[g->nvertices-1-v];
+                r->inv[g->nvertices-1-v] = tmp;
+            }
+            break;
+
+        case REORDER_DEGREE:
+            reorder_degree(g, r->inv);
+            break;
+
+        case REORDER_BFS:
+            reorder_bfs(g, r->inv, 0);
+            break;
+
+        default:
+            for ( v = 0; v < g->nvertices; v++ )
+                r->inv[v] = v;
+            break;
+    }
+
+    for ( v = 0; v < g->nvertices; v++ )
+        r->perm[r->inv[v]] = v;
+
+    return r;
+}
+
+/**
+ * Destroys a vertex relabeling
+ * @param r pointer to relabeling
+ */
+void reorder_destroy(reorder_t *r)
+{
+    free(r->perm);
+    free(r->inv);
+    free(r);
+}
+
+/**
+ * Per-thread state of csr_permute()
+ */
+typedef struct {
+    vid_t vbegin, vend; //!< new vertex range [vbegin,vend)
+    csr_t *g; //!< input graph
+    csr_t *out; //!< relabeled graph
+    reorder_t *r; //!< relabeling
+} reorder_targs_t;
+
+/**
+ * Copies the relabeled rows of a range of new vertices
+ */
+static void* csr_permute_copy(void *args)
+{
+    reorder_targs_t *ta = (reorder_targs_t*)args;
+    csr_t *g = ta->g, *out = ta->out;
+    vid_t u, old;
+    eid_t e, k;
+
+    for ( u = ta->vbegin; u < ta->vend; u++ ) {
+        old = ta->r->inv[u];
+        k = out->offsets[u];
+        for ( e = g->offsets[old]; e < g->offsets[old+1]; e++, k++ ) {
+            out->neighbors[k] = ta->r->perm[g->neighbors[e]];
+            out->weights[k] = g->weights[e];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Builds the relabeled copy of a CSR graph: vertex v of g becomes
+ * vertex r->perm[v]. Each row keeps its neighbor order.
+ * @param g pointer to CSR graph
+ * @param r pointer to relabeling
+ * @return pointer to relabeled CSR graph
+ */
+csr_t* csr_permute(csr_t *g, reorder_t *r)
+{
+    vid_t u;
+    int i, nthreads = parallel_default_nthreads();
+    reorder_targs_t *targs;
+    csr_t *out = csr_init(g->nvertices, g->nedges);
+
+    out->is_undirected = g->is_undirected;
+    for ( u = 0; u < g->nvertices; u++ )
+        out->offsets[u+1] = out->offsets[u] + csr_degree(g, r->inv[u]);
+
+    targs = (reorder_targs_t*)malloc_safe(nthreads * sizeof(reorder_targs_t));
+    for ( i = 0; i < nthreads; i++ ) {
+        targs[i].vbegin = parallel_split_offsets(out->offsets, g->nvertices,
+                                                 nthreads, i);
+        targs[i].vend = parallel_split_offsets(out->offsets, g->nvertices,
+                                               nthreads, i+1);
+        targs[i].g = g;
+        targs[i].out = out;
+        targs[i].r = r;
+    }
+    parallel_run(csr_permute_copy, targs, sizeof(reorder_targs_t), nthreads);
+    free(targs);
+
+    return out;
+}
+
+/**
+ * Computes the bandwidth of a CSR graph, i.e. the maximum id distance
+ * between the endpoints of an edge
+ * @param g pointer to CSR graph
+ * @return graph bandwidth
+ */
+vid_t csr_bandwidth(csr_t *g)
+{
+    vid_t v, w, d, bw = 0;
+    eid_t e;
+
+    for ( v = 0; v < g->nvertices; v++ ) {
+        for ( e = g->offsets[v]; e < g->offsets[v+1]; e++ ) {
+            w = g->neighbors[e];
+            d = v > w ? v - w : w - v;
+            bw = d > bw ? d : bw;
+        }
+    }
+
+    return bw;
+}
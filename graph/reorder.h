@@ -0,0 +1,38 @@
+/**
+ * @file
+ * Vertex reordering type definitions and function declarations
+ */
+
+#ifndef REORDER_H_
+#define REORDER_H_
+
+#include "csr.h"
+#include "graph.h"
+
+/**
+ * Vertex orderings
+ */
+typedef enum {
+    REORDER_NONE = 0, //!< identity
+    REORDER_RCM, //!< reverse Cuthill-McKee
+    REORDER_DEGREE, //!< descending out-degree
+    REORDER_BFS //!< breadth-first visit order
+} reorder_method_t;
+
+/**
+ * A vertex relabeling. perm maps original ids to new ids and inv maps
+ * new ids back to original ids.
+ */
+typedef struct reorder_st {
+    vid_t nvertices; //!< number of vertices
+    vid_t *perm; //!< perm[old] = new
+    vid_t *inv; //!< inv[new] = old
+} reorder_t;
+
+extern reorder_method_t reorder_parse(const char *name);
+extern reorder_t* reorder_compute(csr_t *g, reorder_method_t method);
+extern void reorder_destroy(reorder_t *r);
+extern csr_t* csr_permute(csr_t *g, reorder_t *r);
+extern vid_t csr_bandwidth(csr_t *g);
+
+#endif
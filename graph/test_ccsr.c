@@ -0,0 +1,95 @@
+/**
+ * @file
+ * Tests compressed CSR representation
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ccsr.h"
+#include "csr.h"
+#include "edgelist.h"
+
+/**
+ * Orders vertex ids
+ */
+static int vid_compare(const void *a, const void *b)
+{
+    vid_t x = *(const vid_t*)a, y = *(const vid_t*)b;
+    return x < y ? -1 : (x > y);
+}
+
+/**
+ * Orders edges by (vertex1, vertex2)
+ */
+static int edge_id_compare(const void *a, const void *b)
+{
+    const edge_t *x = (const edge_t*)a, *y = (const edge_t*)b;
+
+    if ( x->vertex1 != y->vertex1 )
+        return x->vertex1 < y->vertex1 ? -1 : 1;
+    return x->vertex2 < y->vertex2 ? -1 : (x->vertex2 > y->vertex2);
+}
+
+int main(int argc, char **argv)
+{
+    int is_undirected = atoi(argv[2]);
+    vid_t v, w, *row;
+    eid_t e, k;
+    weight_t weight;
+    adjlist_stats_t stats;
+    ccsr_iter_t it;
+    csr_t *g;
+    ccsr_t *cg;
+    edgelist_t *el, *cel;
+
+    adjlist_init_stats(&stats);
+    g = csr_read(argv[1], &stats, is_undirected);
+    cg = csr_to_ccsr(g, 3);
+
+    fprintf(stderr, "Printing graph in compressed CSR representation:\n");
+    ccsr_print(cg);
+    fprintf(stderr, "\n\n");
+
+    // Every row must decode to the sorted CSR row
+    assert(cg->nvertices == g->nvertices);
+    assert(cg->nedges == g->nedges);
+    row = (vid_t*)malloc((g->nedges+1) * sizeof(vid_t));
+    for ( v = 0; v < g->nvertices; v++ ) {
+        assert(ccsr_degree(cg, v) == csr_degree(g, v));
+        for ( e = g->offsets[v], k = 0; e < g->offsets[v+1]; e++, k++ )
+            row[k] = g->neighbors[e];
+        qsort(row, k, sizeof(vid_t), vid_compare);
+
+        ccsr_iter_begin(cg, v, &it);
+        for ( e = 0; e < k; e++ ) {
+            assert(ccsr_iter_next(&it, &w, &weight));
+            assert(w == row[e]);
+        }
+        assert(!ccsr_iter_next(&it, &w, &weight));
+    }
+    free(row);
+
+    // Edge lists must hold the same edges
+    el = edgelist_create_csr(g);
+    cel = edgelist_create_ccsr(cg);
+    assert(el->nedges == cel->nedges);
+    qsort(el->edge_array, el->nedges, sizeof(edge_t), edge_id_compare);
+    qsort(cel->edge_array, cel->nedges, sizeof(edge_t), edge_id_compare);
+    for ( e = 0; e < el->nedges; e++ ) {
+        assert(el->edge_array[e].vertex1 == cel->edge_array[e].vertex1);
+        assert(el->edge_array[e].vertex2 == cel->edge_array[e].vertex2);
+        assert(el->edge_array[e].weight == cel->edge_array[e].weight);
+    }
+
+    fprintf(stdout, "%" PRIeid " edges: %zu bytes compressed\n",
+            cg->nedges, ccsr_bytes(cg));
+
+    edgelist_destroy(el);
+    edgelist_destroy(cel);
+    ccsr_destroy(cg);
+    csr_destroy(g);
+
+    return 0;
+}
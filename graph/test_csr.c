@@ -0,0 +1,135 @@
+/**
+ * @file
+ * Tests CSR representation
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "adjlist.h"
+#include "csr.h"
+#include "csr_file.h"
+#include "dimacs.h"
+#include "edgelist.h"
+
+int main(int argc, char **argv)
+{
+    char graphfile[256];
+    int is_undirected = atoi(argv[2]);
+    vid_t v;
+    eid_t e, i;
+    adjlist_stats_t stats_al, stats_csr, stats_ref;
+
+    sprintf(graphfile, "%s", argv[1]);
+
+    adjlist_init_stats(&stats_al);
+    adjlist_init_stats(&stats_csr);
+    adjlist_init_stats(&stats_ref);
+
+    // Reference graph, built by inserting the arcs one at a time
+    dimacs_t *d = dimacs_read(graphfile, 1);
+    adjlist_t *ref = adjlist_init(d->nvertices);
+    ref->is_undirected = is_undirected;
+    for ( i = 0; i < d->narcs; i++ ) {
+        if ( d->src[i] == d->dst[i] ) {
+            stats_ref.nloops++;
+            continue;
+        }
+        adjlist_insert_edge(ref, d->src[i], d->dst[i], d->weight[i], 
+                            &stats_ref);
+        if ( is_undirected )
+            adjlist_insert_edge(ref, d->dst[i], d->src[i], d->weight[i], 
+                                &stats_ref);
+    }
+    dimacs_destroy(d);
+    csr_t *g0 = adjlist_to_csr(ref);
+
+    adjlist_t *al = adjlist_read(graphfile, &stats_al, is_undirected);
+    csr_t *g1 = adjlist_to_csr(al);
+    csr_t *g2 = csr_read(graphfile, &stats_csr, is_undirected);
+
+    fprintf(stderr, "Printing graph in CSR representation:\n");
+    csr_print(g2);
+    fprintf(stderr, "\n\n");
+
+    // All construction paths must yield the same graph
+    assert(g0->nedges == g1->nedges);
+    assert(stats_ref.nedges == stats_al.nedges);
+    assert(stats_ref.nparallel_edges == stats_al.nparallel_edges);
+    assert(stats_ref.nloops == stats_al.nloops);
+    for ( v = 0; v <= g0->nvertices; v++ )
+        assert(g0->offsets[v] == g1->offsets[v]);
+    for ( e = 0; e < g0->nedges; e++ ) {
+        assert(g0->neighbors[e] == g1->neighbors[e]);
+        assert(g0->weights[e] == g1->weights[e]);
+    }
+    assert(g1->nvertices == g2->nvertices);
+    assert(g1->nedges == g2->nedges);
+    assert(stats_al.nedges == stats_csr.nedges);
+    assert(stats_al.nparallel_edges == stats_csr.nparallel_edges);
+    assert(stats_al.nloops == stats_csr.nloops);
+    for ( v = 0; v <= g1->nvertices; v++ )
+        assert(g1->offsets[v] == g2->offsets[v]);
+    for ( e = 0; e < g1->nedges; e++ ) {
+        assert(g1->neighbors[e] == g2->neighbors[e]);
+        assert(g1->weights[e] == g2->weights[e]);
+    }
+
+    // Binary snapshot round trip
+    char snapfile[] = "/tmp/test_csr.XXXXXX";
+    close(mkstemp(snapfile));
+    csr_write_binary(g2, snapfile);
+    assert(csr_is_binary(snapfile));
+    assert(!csr_is_binary(graphfile));
+    csr_t *g3 = csr_mmap(snapfile);
+    assert(g3->nvertices == g2->nvertices);
+    assert(g3->nedges == g2->nedges);
+    assert(g3->is_undirected == g2->is_undirected);
+    for ( v = 0; v <= g2->nvertices; v++ )
+        assert(g3->offsets[v] == g2->offsets[v]);
+    for ( e = 0; e < g2->nedges; e++ ) {
+        assert(g3->neighbors[e] == g2->neighbors[e]);
+        assert(g3->weights[e] == g2->weights[e]);
+    }
+    csr_destroy(g3);
+    unlink(snapfile);
+
+    // Every edge (u,v) appears as (v,u) in the transpose, whose rows 
+    // are sorted
+    csr_t *t = csr_transpose(g2);
+    assert(t->nedges == g2->nedges);
+    for ( v = 0; v < g2->nvertices; v++ ) {
+        for ( e = t->offsets[v]+1; e < t->offsets[v+1]; e++ )
+            assert(t->neighbors[e-1] < t->neighbors[e]);
+        for ( e = g2->offsets[v]; e < g2->offsets[v+1]; e++ ) {
+            vid_t w = g2->neighbors[e];
+            for ( i = t->offsets[w]; t->neighbors[i] != v; i++ )
+                assert(i + 1 < t->offsets[w+1]);
+            assert(t->weights[i] == g2->weights[e]);
+        }
+    }
+    csr_destroy(t);
+
+    edgelist_t *el = edgelist_create_csr(g2);
+    edgelist_t *el_mt = edgelist_create_csr_mt(g2, 3);
+    assert(el_mt->nedges == el->nedges);
+    for ( e = 0; e < el->nedges; e++ ) {
+        assert(el_mt->edge_array[e].vertex1 == el->edge_array[e].vertex1);
+        assert(el_mt->edge_array[e].vertex2 == el->edge_array[e].vertex2);
+        assert(el_mt->edge_array[e].weight == el->edge_array[e].weight);
+    }
+    edgelist_destroy(el_mt);
+    fprintf(stderr, "Printing graph in edge list representation:\n");
+    edgelist_print(el);
+
+    edgelist_destroy(el);
+    csr_destroy(g0);
+    csr_destroy(g1);
+    csr_destroy(g2);
+    adjlist_destroy(al);
+    adjlist_destroy(ref);
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file
+ * Tests dynamic graph batch updates
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "adjlist.h"
+#include "csr.h"
+#include "dyngraph.h"
+#include "edgelist.h"
+
+#define NV 64
+#define NBATCHES 20
+#define BATCH_SIZE 500
+
+/**
+ * Applies operations one at a time to a dense weight matrix
+ * (negative for missing edges)
+ */
+static void ref_apply(weight_t *m, const dyn_op_t *ops, eid_t nops,
+                      int is_undirected)
+{
+    eid_t k;
+    int dir;
+    vid_t s, t;
+
+    for ( k = 0; k < nops; k++ ) {
+        for ( dir = 0; dir <= is_undirected; dir++ ) {
+            s = dir ? ops[k].dst : ops[k].src;
+            t = dir ? ops[k].src : ops[k].dst;
+            if ( ops[k].type == DYN_INSERT && m[s*NV+t] < 0 && s != t )
+                m[s*NV+t] = ops[k].weight;
+            else if ( ops[k].type == DYN_DELETE )
+                m[s*NV+t] = -1;
+            else if ( ops[k].type == DYN_UPDATE && m[s*NV+t] >= 0 )
+                m[s*NV+t] = ops[k].weight;
+        }
+    }
+}
+
+/**
+ * Checks that rows are sorted and match the reference matrix
+ */
+static void check(dyngraph_t *g, const weight_t *m)
+{
+    vid_t v, t;
+    eid_t e, nedges = 0;
+    dyn_row_t *row;
+
+    for ( v = 0; v < NV; v++ ) {
+        row = &g->rows[v];
+        assert(row->deg <= row->cap);
+        for ( e = 0, t = 0; t < NV; t++ ) {
+            if ( m[v*NV+t] < 0 )
+                continue;
+            assert(e < row->deg);
+            assert(row->edges[e].id == t);
+            assert(row->edges[e].weight == m[v*NV+t]);
+            e++;
+        }
+        assert(e == row->deg);
+        nedges += row->deg;
+    }
+    assert(g->nedges == nedges);
+}
+
+static void run(int is_undirected)
+{
+    int b, nthreads;
+    eid_t k;
+    weight_t m[NV*NV];
+    dyngraph_t *g[2];
+    dyn_op_t ops[BATCH_SIZE], unsorted[BATCH_SIZE];
+    dyn_stats_t stats[2];
+    edgelist_t *el;
+
+    for ( k = 0; k < NV*NV; k++ )
+        m[k] = -1;
+    g[0] = dyngraph_create(NV, is_undirected);
+    g[1] = dyngraph_create(NV, is_undirected);
+
+    srand(1);
+    for ( b = 0; b < NBATCHES; b++ ) {
+        for ( k = 0; k < BATCH_SIZE; k++ ) {
+            ops[k].src = rand() % NV;
+            ops[k].dst = rand() % NV;
+            ops[k].weight = rand() % 100;
+            // Mostly insertions at first, then a mix
+            ops[k].type = b < NBATCHES / 4 ? DYN_INSERT : 1 + rand() % 3;
+        }
+        memcpy(unsorted, ops, sizeof(ops));
+        dyngraph_sort_batch(ops, BATCH_SIZE);
+        for ( k = 1; k < BATCH_SIZE; k++ )
+            assert(ops[k-1].src < ops[k].src || (ops[k-1].src == ops[k].src
+                                                 && ops[k-1].dst <= ops[k].dst));
+
+        ref_apply(m, ops, BATCH_SIZE, is_undirected);
+        // A directed batch has the same effect unsorted, since sorting
+        // keeps the order of the operations on each edge
+        for ( nthreads = 0; nthreads < 2; nthreads++ ) {
+            dyngraph_apply(g[nthreads], 
+                           nthreads && !is_undirected ? unsorted : ops, 
+                           BATCH_SIZE, &stats[nthreads], nthreads ? 4 : 1);
+            check(g[nthreads], m);
+        }
+        assert(stats[0].ninserted == stats[1].ninserted);
+        assert(stats[0].ndeleted == stats[1].ndeleted);
+        assert(stats[0].nupdated == stats[1].nupdated);
+    }
+
+    el = edgelist_create_dyn(g[0]);
+    assert(el->nedges == (is_undirected ? g[0]->nedges / 2 : g[0]->nedges));
+    for ( k = 0; k < el->nedges; k++ )
+        assert(m[el->edge_array[k].vertex1 * NV + el->edge_array[k].vertex2]
+               == el->edge_array[k].weight);
+    edgelist_destroy(el);
+
+    fprintf(stdout, "%s: %" PRIeid " edges after %d batches\n",
+            is_undirected ? "undirected" : "directed", g[0]->nedges, NBATCHES);
+
+    dyngraph_destroy(g[0]);
+    dyngraph_destroy(g[1]);
+}
+
+int main(int argc, char **argv)
+{
+    adjlist_stats_t stats;
+    csr_t *csr;
+    dyngraph_t *g;
+    vid_t v;
+    eid_t e;
+
+    run(0);
+    run(1);
+
+    // Conversion from CSR keeps all edges, in sorted rows
+    if ( argc > 1 ) {
+        adjlist_init_stats(&stats);
+        csr = csr_read(argv[1], &stats, 0);
+        g = csr_to_dyngraph(csr, 4);
+        assert(g->nedges == csr->nedges);
+        for ( v = 0; v < g->nvertices; v++ ) {
+            assert(dyngraph_degree(g, v) == csr_degree(csr, v));
+            for ( e = 1; e < g->rows[v].deg; e++ )
+                assert(g->rows[v].edges[e-1].id < g->rows[v].edges[e].id);
+        }
+        dyngraph_print(g);
+        dyngraph_destroy(g);
+        csr_destroy(csr);
+    }
+
+    return 0;
+}
@@ -3,17 +3,73 @@
  * Tests edge list representation
  */ 
 
+#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "adjlist.h"
 #include "edgelist.h"
 
+/**
+ * Edge with its position before sorting
+ */ 
+typedef struct {
+    edge_t edge;
+    eid_t pos;
+} indexed_edge_t;
+
+/**
+ * Orders by weight, then by position: a stable sort
+ */ 
+static int indexed_edge_compare(const void *a, const void *b)
+{
+    const indexed_edge_t *e1 = (const indexed_edge_t*)a;
+    const indexed_edge_t *e2 = (const indexed_edge_t*)b;
+    int c = edge_compare(&e1->edge, &e2->edge);
+
+    return c ? c : (e1->pos > e2->pos) - (e1->pos < e2->pos);
+}
+
+/**
+ * Checks the radix sort of an edge list with 1 and 3 threads against a
+ * stable qsort (weights of equal value, like -0 and 0, compare by bit
+ * pattern in the radix sort, so they must not be mixed here)
+ */ 
+static void check_sort(const edgelist_t *el)
+{
+    eid_t e;
+    int nthreads;
+    edgelist_t sorted = *el;
+    indexed_edge_t *ref = (indexed_edge_t*)malloc(el->nedges * 
+                                                  sizeof(indexed_edge_t));
+
+    for ( e = 0; e < el->nedges; e++ ) {
+        ref[e].edge = el->edge_array[e];
+        ref[e].pos = e;
+    }
+    qsort(ref, el->nedges, sizeof(indexed_edge_t), indexed_edge_compare);
+
+    sorted.edge_array = (edge_t*)malloc(el->nedges * sizeof(edge_t));
+    for ( nthreads = 1; nthreads <= 3; nthreads += 2 ) {
+        memcpy(sorted.edge_array, el->edge_array, 
+               el->nedges * sizeof(edge_t));
+        edgelist_sort(&sorted, nthreads);
+        for ( e = 0; e < el->nedges; e++ )
+            assert(memcmp(&sorted.edge_array[e], &ref[e].edge, 
+                          sizeof(edge_t)) == 0);
+    }
+
+    free(sorted.edge_array);
+    free(ref);
+}
+
 
 int main(int argc, char **argv) 
 {
     char graphfile[256];
     int is_undirected = atoi(argv[2]);
+    eid_t e;
     adjlist_stats_t stats;
 
     sprintf(graphfile, "%s", argv[1]);
@@ -26,11 +82,22 @@ int main(int argc, char **argv)
     fprintf(stderr, "\n\n");
     
     edgelist_t *el = edgelist_create(al);
+
+    // The parallel builder must produce the very same edge list
+    edgelist_t *el_mt = edgelist_create_mt(al, 4);
+    assert(el_mt->nedges == el->nedges);
+    for ( e = 0; e < el->nedges; e++ ) {
+        assert(el_mt->edge_array[e].vertex1 == el->edge_array[e].vertex1);
+        assert(el_mt->edge_array[e].vertex2 == el->edge_array[e].vertex2);
+        assert(el_mt->edge_array[e].weight == el->edge_array[e].weight);
+    }
+    edgelist_destroy(el_mt);
     
     fprintf(stderr, "Printing graph in edge list representation:\n");
     edgelist_print(el);
 
-    qsort(el->edge_array, el->nedges, sizeof(edge_t), edge_compare);
+    check_sort(el);
+    edgelist_sort(el, 0);
 
     fprintf(stderr, "\nPrinting graph after sorting:\n");
     edgelist_print(el);
@@ -38,5 +105,22 @@ int main(int argc, char **argv)
     edgelist_destroy(el);
     adjlist_destroy(al);
 
+    // Random weights, negative ones and many duplicates included, over
+    // enough edges to split the sort among threads
+    edgelist_t rnd;
+    rnd.nvertices = 1000;
+    rnd.nedges = 300000;
+    rnd.is_undirected = 0;
+    rnd.edge_array = (edge_t*)malloc(rnd.nedges * sizeof(edge_t));
+    srand(1);
+    for ( e = 0; e < rnd.nedges; e++ ) {
+        rnd.edge_array[e].vertex1 = rand() % rnd.nvertices;
+        rnd.edge_array[e].vertex2 = rand() % rnd.nvertices;
+        rnd.edge_array[e].weight = e % 2 ? (weight_t)(rand() % 100 - 50)
+                                         : (weight_t)rand() / RAND_MAX - 0.5f;
+    }
+    check_sort(&rnd);
+    free(rnd.edge_array);
+
     return 0;
 }
@@ -0,0 +1,85 @@
+/**
+ * @file
+ * Tests synthetic graph generators
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "adjlist.h"
+#include "csr.h"
+#include "dimacs.h"
+#include "generators.h"
+
+/**
+ * Checks that a specification generates the same arcs with 1 and with
+ * several threads, and that it builds into a valid graph
+ */
+static void check_spec(const char *spec)
+{
+    int is_undirected, is_undirected_mt;
+    eid_t i;
+    adjlist_stats_t stats;
+    dimacs_t *d = gen_from_spec(spec, &is_undirected, 1);
+    dimacs_t *d_mt = gen_from_spec(spec, &is_undirected_mt, 4);
+    csr_t *g;
+
+    assert(gen_is_spec(spec));
+    assert(is_undirected == is_undirected_mt);
+    assert(d->nvertices == d_mt->nvertices);
+    assert(d->narcs == d_mt->narcs);
+    for ( i = 0; i < d->narcs; i++ ) {
+        assert(d->src[i] == d_mt->src[i]);
+        assert(d->dst[i] == d_mt->dst[i]);
+        assert(d->weight[i] == d_mt->weight[i]);
+        assert(d->src[i] < d->nvertices);
+        assert(d->dst[i] < d->nvertices);
+        assert(d->src[i] != d->dst[i]);
+        assert(d->weight[i] >= 0);
+    }
+
+    adjlist_init_stats(&stats);
+    g = csr_build(d->nvertices, d->narcs, d->src, d->dst, d->weight,
+                  &stats, is_undirected, 0);
+    assert(stats.nloops == 0);
+
+    fprintf(stdout, "%s: %" PRIvid " vertices, %" PRIeid " arcs, "
+                    "%" PRIeid " edges (%" PRIeid " parallel)\n",
+            spec, d->nvertices, d->narcs, g->nedges, stats.nparallel_edges);
+
+    csr_destroy(g);
+    dimacs_destroy(d);
+    dimacs_destroy(d_mt);
+}
+
+int main(int argc, char **argv)
+{
+    int is_undirected;
+    dimacs_t *d;
+
+    check_spec("rmat:10:8");
+    check_spec("rmat:10:8:7");
+    check_spec("grid2d:30:20");
+    check_spec("grid3d:10:8:6:3");
+    check_spec("geo:2000:6");
+
+    // A 30x20 grid has 29*20 + 30*19 edges
+    d = gen_from_spec("grid2d:30:20", &is_undirected, 0);
+    assert(is_undirected);
+    assert(d->nvertices == 600);
+    assert(d->narcs == 29*20 + 30*19);
+    dimacs_destroy(d);
+
+    // Different seeds give different graphs
+    d = gen_from_spec("rmat:10:8:7", &is_undirected, 0);
+    dimacs_t *d2 = gen_from_spec("rmat:10:8:8", &is_undirected, 0);
+    assert(d->src[0] != d2->src[0] || d->dst[0] != d2->dst[0] ||
+           d->src[1] != d2->src[1] || d->dst[1] != d2->dst[1]);
+    dimacs_destroy(d);
+    dimacs_destroy(d2);
+
+    assert(!gen_is_spec("graph1.gr"));
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file
+ * Tests vertex reordering
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "adjlist.h"
+#include "csr.h"
+#include "reorder.h"
+
+int main(int argc, char **argv)
+{
+    const char *names[] = { "none", "rcm", "degree", "bfs" };
+    int is_undirected = atoi(argv[2]), m;
+    vid_t v, *seen;
+    eid_t e, k;
+    adjlist_stats_t stats;
+    reorder_t *r;
+    csr_t *g, *h;
+
+    adjlist_init_stats(&stats);
+    g = csr_read(argv[1], &stats, is_undirected);
+    seen = (vid_t*)malloc(g->nvertices * sizeof(vid_t));
+
+    for ( m = 0; m < 4; m++ ) {
+        r = reorder_compute(g, reorder_parse(names[m]));
+
+        // perm must be a permutation, and inv its inverse
+        memset(seen, 0, g->nvertices * sizeof(vid_t));
+        for ( v = 0; v < g->nvertices; v++ ) {
+            assert(r->perm[v] < g->nvertices);
+            assert(!seen[r->perm[v]]);
+            seen[r->perm[v]] = 1;
+            assert(r->inv[r->perm[v]] == v);
+        }
+
+        // The relabeled graph must have the same rows, relabeled
+        h = csr_permute(g, r);
+        assert(h->nedges == g->nedges);
+        assert(h->is_undirected == g->is_undirected);
+        for ( v = 0; v < g->nvertices; v++ ) {
+            assert(csr_degree(h, r->perm[v]) == csr_degree(g, v));
+            k = h->offsets[r->perm[v]];
+            for ( e = g->offsets[v]; e < g->offsets[v+1]; e++, k++ ) {
+                assert(h->neighbors[k] == r->perm[g->neighbors[e]]);
+                assert(h->weights[k] == g->weights[e]);
+            }
+        }
+
+        fprintf(stdout, "%s: bandwidth %" PRIvid " -> %" PRIvid "\n",
+                names[m], csr_bandwidth(g), csr_bandwidth(h));
+
+        csr_destroy(h);
+        reorder_destroy(r);
+    }
+
+    free(seen);
+    csr_destroy(g);
+
+    return 0;
+}
@@ -0,0 +1,270 @@
+/**
+ * @file 
+ * Filter-Kruskal MSF algorithm definitions
+ */ 
+
+#include "filter_kruskal.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph/parallel.h"
+
+/**
+ * Fewest edges per filtering thread worth a thread
+ */
+#define FILTER_KRUSKAL_GRAIN 65536
+
+/**
+ * Edge with its sort key and its position in the edge list
+ */ 
+typedef struct fk_edge_st {
+    edge_t edge; //!< edge
+    uint32_t key; //!< edgelist_weight_key() of the edge weight
+    eid_t id; //!< edge list position
+} fk_edge_t;
+
+/**
+ * State shared by the recursion
+ */ 
+typedef struct fk_state_st {
+    uf_t *uf; //!< disjoint sets of the vertices
+    unsigned int *edge_membership; //!< output, by edge list position
+    vid_t remaining; //!< unions left until a spanning tree is complete
+    int nthreads; //!< number of filtering threads
+} fk_state_t;
+
+/**
+ * Per-thread state of the filter
+ */ 
+typedef struct fk_filter_targs_st {
+    uf_t *uf; //!< disjoint sets of the vertices
+    fk_edge_t *edges; //!< edges to filter
+    eid_t begin, end; //!< slice of this thread
+    eid_t nkept; //!< edges kept, moved to the slice start (output)
+} fk_filter_targs_t;
+
+/**
+ * Strict total order of the edges: by weight key, as edgelist_sort() 
+ * orders them, then by position
+ */ 
+static inline int fk_less(const fk_edge_t *a, const fk_edge_t *b)
+{
+    return a->key < b->key || (a->key == b->key && a->id < b->id);
+}
+
+/**
+ * Moves the edges not above the pivot to the front
+ * @return number of edges not above the pivot
+ */ 
+static eid_t fk_partition(fk_edge_t *edges, eid_t n, const fk_edge_t *pivot)
+{
+    eid_t i = 0, j = n;
+    fk_edge_t t;
+
+    // Swap the first heavy edge from the left with the first light one 
+    // from the right
+    while ( i < j ) {
+        if ( !fk_less(pivot, &edges[i]) ) {
+            i++;
+            continue;
+        }
+        while ( i < j - 1 && fk_less(pivot, &edges[j-1]) )
+            j--;
+        if ( --j > i ) {
+            t = edges[i];
+            edges[i++] = edges[j];
+            edges[j] = t;
+        }
+    }
+
+    return i;
+}
+
+/**
+ * Returns the median of the first, middle and last edges (n >= 3), so 
+ * that both sides of a partition around it are non-empty
+ */ 
+static fk_edge_t fk_pivot(const fk_edge_t *edges, eid_t n)
+{
+    const fk_edge_t *a = &edges[0], *b = &edges[n/2], *c = &edges[n-1];
+
+    if ( fk_less(a, b) )
+        return fk_less(b, c) ? *b : (fk_less(a, c) ? *c : *a);
+    return fk_less(a, c) ? *a : (fk_less(b, c) ? *c : *b);
+}
+
+/**
+ * Sorts edges in fk_less() order: quicksort down to short runs, then 
+ * insertion sort, with the comparison inlined
+ */ 
+static void fk_sort(fk_edge_t *edges, eid_t n)
+{
+    eid_t i, j, nlight;
+    fk_edge_t pivot, t;
+
+    while ( n > 16 ) {
+        pivot = fk_pivot(edges, n);
+        nlight = fk_partition(edges, n, &pivot);
+        if ( nlight < n - nlight ) {
+            fk_sort(edges, nlight);
+            edges += nlight;
+            n -= nlight;
+        } else {
+            fk_sort(edges + nlight, n - nlight);
+            n = nlight;
+        }
+    }
+
+    for ( i = 1; i < n; i++ ) {
+        t = edges[i];
+        for ( j = i; j > 0 && fk_less(&t, &edges[j-1]); j-- )
+            edges[j] = edges[j-1];
+        edges[j] = t;
+    }
+}
+
+/**
+ * Base case: sorts the edges and runs Kruskal over them
+ */ 
+static void fk_base(fk_state_t *st, fk_edge_t *edges, eid_t n)
+{
+    eid_t i;
+    vid_t set1, set2;
+
+    fk_sort(edges, n);
+    for ( i = 0; i < n && st->remaining > 0; i++ ) {
+        set1 = uf_find(st->uf, edges[i].edge.vertex1);
+        set2 = uf_find(st->uf, edges[i].edge.vertex2);
+        if ( set1 != set2 ) {
+            uf_union(st->uf, set1, set2);
+            st->edge_membership[edges[i].id] = 1;
+            st->remaining--;
+        }
+    }
+}
+
+/**
+ * Filtering thread: keeps, in order at the start of its slice, the 
+ * edges whose endpoints are still in different sets. Finds may run in
+ * all threads at once, so they are the concurrent ones.
+ */ 
+static void* fk_filter_thread(void *args)
+{
+    fk_filter_targs_t *ta = (fk_filter_targs_t*)args;
+    eid_t i, k = ta->begin;
+
+    for ( i = ta->begin; i < ta->end; i++ ) {
+        if ( uf_find_atomic(ta->uf, ta->edges[i].edge.vertex1) != 
+             uf_find_atomic(ta->uf, ta->edges[i].edge.vertex2) )
+            ta->edges[k++] = ta->edges[i];
+    }
+    ta->nkept = k - ta->begin;
+
+    return NULL;
+}
+
+/**
+ * Drops the edges whose endpoints are already connected, keeping the 
+ * order of the others
+ * @return number of edges kept
+ */ 
+static eid_t fk_filter(fk_state_t *st, fk_edge_t *edges, eid_t n)
+{
+    fk_filter_targs_t targs[st->nthreads];
+    int i, nthreads = st->nthreads;
+    eid_t k;
+
+    if ( n < (eid_t)nthreads * FILTER_KRUSKAL_GRAIN )
+        nthreads = (int)(n / FILTER_KRUSKAL_GRAIN) + 1;
+
+    for ( i = 0; i < nthreads; i++ ) {
+        targs[i].uf = st->uf;
+        targs[i].edges = edges;
+        targs[i].begin = n * i / nthreads;
+        targs[i].end = n * (i + 1) / nthreads;
+    }
+    parallel_run(fk_filter_thread, targs, sizeof(fk_filter_targs_t), 
+                 nthreads);
+
+    // Close the gaps between the slices
+    k = targs[0].nkept;
+    for ( i = 1; i < nthreads; i++ ) {
+        memmove(&edges[k], &edges[targs[i].begin], 
+                targs[i].nkept * sizeof(fk_edge_t));
+        k += targs[i].nkept;
+    }
+
+    return k;
+}
+
+/**
+ * Filter-Kruskal on a part of the edges: the light side of the pivot 
+ * recursively, then the filtered heavy side in the same loop
+ */ 
+static void fk_recurse(fk_state_t *st, fk_edge_t *edges, eid_t n)
+{
+    eid_t nlight;
+    fk_edge_t pivot;
+
+    while ( n > 0 && st->remaining > 0 ) {
+        if ( n <= FILTER_KRUSKAL_THRESHOLD || n < 3 ) {
+            fk_base(st, edges, n);
+            return;
+        }
+
+        pivot = fk_pivot(edges, n);
+        nlight = fk_partition(edges, n, &pivot);
+        fk_recurse(st, edges, nlight);
+
+        edges += nlight;
+        n = fk_filter(st, edges, n - nlight);
+    }
+}
+
+/**
+ * Runs the Filter-Kruskal MSF algorithm over an edge list in any order
+ * @param el pointer to edge list (left unchanged)
+ * @param uf disjoint sets, one singleton per vertex
+ * @param edge_membership designates whether an edge is part of the MSF
+ *                        (zero-initialized, as by kruskal_init())
+ * @param nthreads number of filtering threads (<=0 for all online 
+ *                 processors)
+ */ 
+void filter_kruskal(edgelist_t *el,
+                    uf_t *uf,
+                    unsigned int *edge_membership,
+                    int nthreads)
+{
+    eid_t e;
+    fk_state_t st;
+    fk_edge_t *edges;
+
+    assert(uf);
+    assert(edge_membership);
+
+    if ( nthreads <= 0 )
+        nthreads = parallel_default_nthreads();
+
+    edges = (fk_edge_t*)malloc((el->nedges ? el->nedges : 1) * 
+                               sizeof(fk_edge_t));
+    if ( !edges ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+    for ( e = 0; e < el->nedges; e++ ) {
+        edges[e].edge = el->edge_array[e];
+        edges[e].key = edgelist_weight_key(el->edge_array[e].weight);
+        edges[e].id = e;
+    }
+
+    st.uf = uf;
+    st.edge_membership = edge_membership;
+    st.remaining = el->nvertices ? el->nvertices - 1 : 0;
+    st.nthreads = nthreads;
+    fk_recurse(&st, edges, el->nedges);
+
+    free(edges);
+}
@@ -0,0 +1,37 @@
+/**
+ * @file
+ * Filter-Kruskal MSF algorithm declarations.
+ *
+ * Instead of sorting all edges up front, the edges are split around a
+ * pivot weight as in quicksort. The light part is solved first, and 
+ * recursively; the heavy part is then filtered, dropping in parallel 
+ * every edge whose endpoints the light edges already connect, and only
+ * the survivors are split again. Small parts are sorted and scanned as
+ * in kruskal(). On dense graphs most heavy edges are filtered out 
+ * before they are ever sorted.
+ *
+ * Edges are ordered as edgelist_sort() orders them (by 
+ * edgelist_weight_key(), so -0 before +0), and edges of equal weight 
+ * by their edge list position, so the MSF is the one kruskal() finds 
+ * after kruskal_sort_edges().
+ */ 
+
+#ifndef FILTER_KRUSKAL_H_
+#define FILTER_KRUSKAL_H_
+
+#include "graph/edgelist.h"
+#include "disjoint_sets/flat_union_find.h"
+
+/**
+ * Largest part sorted and scanned directly
+ */ 
+#ifndef FILTER_KRUSKAL_THRESHOLD
+#define FILTER_KRUSKAL_THRESHOLD 1024
+#endif
+
+void filter_kruskal(edgelist_t *el,
+                    uf_t *uf,
+                    unsigned int *edge_membership,
+                    int nthreads);
+
+#endif
@@ -11,35 +11,20 @@
 
 
 /**
- * Allocate and initialize Kruskal structures
- * @param el pointer to sorted edge list 
- * @param al pointer to adjacency list graph representation 
- * @param fnode_array address of the pointer to forest nodes array
+ * Allocate the disjoint sets and the output array
+ * @param el pointer to edge list 
+ * @param uf address of the pointer to the disjoint sets
  * @param edge_membership address to the array that designates whether 
  *                        an edge is part of the MSF
  */
-void kruskal_init(edgelist_t *el,
-                  adjlist_t *al,
-                  forest_node_t ***fnode_array,
-                  unsigned int **edge_membership)
+static void kruskal_alloc(edgelist_t *el,
+                          uf_t **uf,
+                          unsigned int **edge_membership)
 {
-    unsigned int v, e;
-
-    assert(al);
-    assert(el);
-    assert(el->edge_array);
-
-    // Create and initialize forest nodes
-    *fnode_array = (forest_node_t**)malloc(el->nvertices * 
-                                           sizeof(forest_node_t*) );
-    if ( ! *fnode_array ) {
-        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
-        exit(EXIT_FAILURE);
-    }
+    eid_t e;
 
     // Make a set from each vertex of the graph
-    for ( v = 0; v < al->nvertices; v++ ) 
-        (*fnode_array)[v] = make_set(al->adj[v]);
+    *uf = uf_create(el->nvertices);
 
     // Create and initialize output array
     *edge_membership = (unsigned int*)malloc(el->nedges * 
@@ -53,47 +38,86 @@ void kruskal_init(edgelist_t *el,
 }
 
 /**
- * Sort edge list
+ * Allocate and initialize Kruskal structures
  * @param el pointer to sorted edge list 
+ * @param al pointer to adjacency list graph representation 
+ * @param uf address of the pointer to the disjoint sets
+ * @param edge_membership address to the array that designates whether 
+ *                        an edge is part of the MSF
  */
-void kruskal_sort_edges(edgelist_t *el)
+void kruskal_init(edgelist_t *el,
+                  adjlist_t *al,
+                  uf_t **uf,
+                  unsigned int **edge_membership)
+{
+    assert(al);
+    assert(el);
+    assert(el->edge_array);
+
+    kruskal_alloc(el, uf, edge_membership);
+}
+
+/**
+ * Allocate and initialize Kruskal structures for a CSR graph
+ * @param el pointer to sorted edge list 
+ * @param g pointer to CSR graph representation 
+ * @param uf address of the pointer to the disjoint sets
+ * @param edge_membership address to the array that designates whether 
+ *                        an edge is part of the MSF
+ */
+void kruskal_init_csr(edgelist_t *el,
+                      csr_t *g,
+                      uf_t **uf,
+                      unsigned int **edge_membership)
 {
-    unsigned int v, e;
+    assert(g);
+    assert(el);
+    assert(el->edge_array);
 
+    kruskal_alloc(el, uf, edge_membership);
+}
+
+/**
+ * Sort edge list by non-decreasing weight, on all processors. The 
+ * sort is stable, so equal-weight edges keep their edge list order.
+ * @param el pointer to sorted edge list 
+ */
+void kruskal_sort_edges(edgelist_t *el)
+{
     assert(el);
     assert(el->edge_array);
 
-    // Sort edge list by non-decreasing weight
-    qsort(el->edge_array, el->nedges, sizeof(edge_t), edge_compare);
+    edgelist_sort(el, 0);
 }
 
 
 /**
  * Runs Kruskal MSF algorithm
  * @param el pointer to sorted edge list 
- * @param fnode_array pointer to forest nodes array
+ * @param uf disjoint sets, one singleton per vertex
  * @param edge_membership designates whether an edge is part of the MSF
  */ 
 void kruskal(edgelist_t *el, 
-             forest_node_t **fnode_array,
+             uf_t *uf,
              unsigned int *edge_membership)
 {
-    unsigned int i;
+    eid_t i;
     edge_t *pe;
+    vid_t set1, set2;
     
-    assert(fnode_array);
+    assert(uf);
     assert(edge_membership);
 
     // For each edge, in order by non-decreasing weight...
     for ( i = 0; i < el->nedges; i++ ) { 
         pe = &(el->edge_array[i]);
 
-        forest_node_t *set1 = find_set(fnode_array[pe->vertex1]);
-        forest_node_t *set2 = find_set(fnode_array[pe->vertex2]);
+        set1 = uf_find(uf, pe->vertex1);
+        set2 = uf_find(uf, pe->vertex2);
 
         // vertices belong to different forests
         if ( set1 != set2 ) {
-            union_sets(set1, set2);
+            uf_union(uf, set1, set2);
             edge_membership[i] = 1;
         } 
     }
@@ -102,19 +126,31 @@ void kruskal(edgelist_t *el,
 /**
  * Deallocate Kruskal structures
  * @param al pointer to adjacency list graph representation 
- * @param fnode_array forest nodes array
+ * @param uf disjoint sets
  * @param edge_membership designates whether an edge is part of the MSF
  */
 void kruskal_destroy(adjlist_t *al,
-                     forest_node_t **fnode_array, 
+                     uf_t *uf, 
                      unsigned int *edge_membership)
 {
-    unsigned int v;
-
     assert(al);
     
-    for ( v = 0; v < al->nvertices; v++ )
-       destroy_set(fnode_array[v]);
-    free(fnode_array);
+    uf_destroy(uf);
+    free(edge_membership);
+}
+
+/**
+ * Deallocate Kruskal structures created by kruskal_init_csr()
+ * @param g pointer to CSR graph representation 
+ * @param uf disjoint sets
+ * @param edge_membership designates whether an edge is part of the MSF
+ */
+void kruskal_destroy_csr(csr_t *g,
+                         uf_t *uf, 
+                         unsigned int *edge_membership)
+{
+    assert(g);
+    
+    uf_destroy(uf);
     free(edge_membership);
 }
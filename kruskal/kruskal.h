@@ -8,20 +8,30 @@
 
 #include "graph/edgelist.h"
 #include "graph/adjlist.h"
-#include "disjoint_sets/union_find.h"
+#include "graph/csr.h"
+#include "disjoint_sets/flat_union_find.h"
 
 void kruskal_init(edgelist_t *el,
                   adjlist_t *al,
-                  forest_node_t ***fnode_array,
+                  uf_t **uf,
                   unsigned int **edge_membership);
 
+void kruskal_init_csr(edgelist_t *el,
+                      csr_t *g,
+                      uf_t **uf,
+                      unsigned int **edge_membership);
+
 void kruskal_sort_edges(edgelist_t *el);
 
 void kruskal(edgelist_t *el, 
-             forest_node_t **node_array,  
+             uf_t *uf,
              unsigned int *edge_membership);
 
 void kruskal_destroy(adjlist_t *al,
-                     forest_node_t **fnode_array, 
+                     uf_t *uf, 
                      unsigned int *edge_membership);
+
+void kruskal_destroy_csr(csr_t *g,
+                         uf_t *uf, 
+                         unsigned int *edge_membership);
 #endif
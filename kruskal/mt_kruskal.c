@@ -11,7 +11,7 @@
 
 #include "mt_kruskal.h"
 
-#include "disjoint_sets/union_find.h"
+#include "disjoint_sets/flat_union_find.h"
 #include "graph/adjlist.h"
 #include "graph/graph.h"
 #include "graph/edgelist.h"
@@ -22,7 +22,7 @@ int main_finished;
 extern pthread_barrier_t bar;
 extern tsctimer_t tim;
 extern edgelist_t *el;
-extern forest_node_t **fnode_array;
+extern uf_t *vertex_sets;
 extern char *edge_color_main;
 extern char *edge_color_helper;
 
@@ -36,7 +36,7 @@ void kruskal_helper_init(edgelist_t *el,
                          char **edge_color_main, 
                          char **edge_color_helper)
 {
-    unsigned int e;
+    eid_t e;
 
     *edge_color_main = (char*)malloc(el->nedges * sizeof(char));
     if ( ! *edge_color_main ) {
@@ -67,21 +67,6 @@ void kruskal_helper_destroy(char *edge_color_main,
     free(edge_color_helper);
 }
 
-/**
- * Find-set function for helper threads. Operates as the original 
- * find-set, without compressing the path
- * @param node the node whose set we want to find
- * @return the root of the subtree where the node belongs to
- */ 
-static inline forest_node_t* find_set_helper(forest_node_t* node) 
-{
-    forest_node_t* root = node;
-    while ( root->parent != NULL )
-        root = root->parent;
-        
-    return root;
-}
-
 /**
  * Kruskal-HT thread function
  */ 
@@ -89,14 +74,14 @@ void *kruskal_ht(void *args)
 {
     targs_t *thread_args = (targs_t*)args;
     int id = thread_args->id;
-    int begin = thread_args->begin;
-    int end = thread_args->end;
+    eid_t begin = thread_args->begin;
+    eid_t end = thread_args->end;
     int thread_type = thread_args->type;
-    unsigned int i;
-    forest_node_t *set1, *set2;
+    eid_t i;
+    vid_t set1, set2;
     edge_t *pe;
 
-    assert(fnode_array);
+    assert(vertex_sets);
 
     // Code for the Main Thread
     if ( thread_type == MAIN_THR ) {
@@ -112,11 +97,11 @@ void *kruskal_ht(void *args)
             if( edge_color_helper[i] != 0 ) 
                 continue;
             else {
-                set1 = find_set(fnode_array[pe->vertex1]);
-                set2 = find_set(fnode_array[pe->vertex2]);
+                set1 = uf_find(vertex_sets, pe->vertex1);
+                set2 = uf_find(vertex_sets, pe->vertex2);
                 
                 if ( set1 != set2 ) {
-                    union_sets(set1, set2);
+                    uf_union(vertex_sets, set1, set2);
                     edge_color_main[i] = MSF_EDGE;
                 } else 
                     edge_color_main[i] = CYCLE_EDGE_MAIN;
@@ -143,8 +128,8 @@ void *kruskal_ht(void *args)
 
             if ( edge_color_helper[i] == 0 ) {
                 pe = &(el->edge_array[i]);
-                set1 = find_set_helper(fnode_array[pe->vertex1]);
-                set2 = find_set_helper(fnode_array[pe->vertex2]);
+                set1 = uf_find_readonly(vertex_sets, pe->vertex1);
+                set2 = uf_find_readonly(vertex_sets, pe->vertex2);
                 
                 if ( set1 == set2 ) 
                     edge_color_helper[i] = id + 1;
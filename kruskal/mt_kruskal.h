@@ -2,6 +2,7 @@
 #define MT_KRUSKAL_H_
 
 #include "graph/edgelist.h"
+#include "graph/graph.h"
 
 #define MSF_EDGE 100
 #define CYCLE_EDGE_MAIN 1
@@ -11,7 +12,7 @@ enum { MAIN_THR = 1, HELPER_THR };
 typedef struct {
     int id; // thread-id
     int type; // thread type (main / helper)
-    int begin, end; // thread bounds
+    eid_t begin, end; // thread bounds
 } targs_t;
 
 void kruskal_helper_init(edgelist_t *el, 
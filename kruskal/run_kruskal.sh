@@ -2,6 +2,8 @@
 
 # $GRAPH_SIZE: 10K, 100K, 1M, 10M
 # is env variable and must be set from where qsub is called from
+# $GRAPH_SPECS: optional list of generator specs (e.g. "rmat:24:16 
+# grid2d:4000:4000") used instead of the graph files
 
 cd $HOME/trac/kruskal/
 
@@ -11,7 +13,9 @@ proc_num=$(cat /proc/cpuinfo | grep "processor" | wc -l)
 outfile=$(hostname)_output_${GRAPH_SIZE}graphs.txt
 rm -f $outfile
 
-for g in $(ls /local/graphs/$GRAPH_SIZE/*.gr)
+graphs=${GRAPH_SPECS:-$(ls /local/graphs/$GRAPH_SIZE/*.gr)}
+
+for g in $graphs
 do
     ./test_mt_kruskal $g $proc_num 0 >> $outfile
     ./test_mt_kruskal $g $proc_num 1 >> $outfile
@@ -0,0 +1,139 @@
+/**
+ * @file
+ * Checks Filter-Kruskal against sort-then-scan Kruskal, edge by edge,
+ * for 1 and several threads, and times both
+ */
+
+#include "filter_kruskal.h"
+#include "kruskal.h"
+#include "graph/adjlist.h"
+#include "graph/csr.h"
+#include "graph/dimacs.h"
+#include "graph/edgelist.h"
+#include "graph/generators.h"
+#include "graph/graph.h"
+#include "util/tsc_x86_64.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const edge_t *order_edges;
+
+/**
+ * Orders edge positions by weight key, then by position, as the stable 
+ * kruskal_sort_edges() does
+ */ 
+static int order_compare(const void *a, const void *b)
+{
+    eid_t i = *(const eid_t*)a, j = *(const eid_t*)b;
+    uint32_t ki = edgelist_weight_key(order_edges[i].weight);
+    uint32_t kj = edgelist_weight_key(order_edges[j].weight);
+
+    if ( ki != kj )
+        return ki < kj ? -1 : 1;
+    return (i > j) - (i < j);
+}
+
+/**
+ * A triangle whose only -0 edge comes last: the sort puts it before 
+ * the two +0 edges, so it is in the MSF and the last +0 edge is not
+ */ 
+static void check_signed_zero(void)
+{
+    edge_t edges[3] = { { 0, 1, 0.0f }, { 1, 2, 0.0f }, { 0, 2, -0.0f } };
+    edgelist_t el = { 3, 3, edges, 1 };
+    unsigned int *membership;
+    uf_t *uf;
+
+    uf = uf_create(el.nvertices);
+    membership = (unsigned int*)calloc(el.nedges, sizeof(unsigned int));
+    filter_kruskal(&el, uf, membership, 1);
+    assert(membership[0] && !membership[1] && membership[2]);
+    free(membership);
+    uf_destroy(uf);
+}
+
+int main(int argc, char **argv)
+{
+    csr_t *g;
+    adjlist_stats_t stats;
+    dimacs_t *d;
+    int is_undirected, k, nthreads;
+    eid_t e, *order;
+    edgelist_t *el, *sorted;
+    unsigned int *membership, *fk_membership;
+    uf_t *uf;
+    tsctimer_t t_kruskal, t_filter;
+    double hz;
+
+    if ( argc < 2 ) {
+        printf("Usage: ./test_filter_kruskal <graphfile|generator spec> "
+               "[nthreads]\n");
+        exit(EXIT_FAILURE);
+    }
+    nthreads = argc > 2 ? atoi(argv[2]) : 4;
+
+    check_signed_zero();
+
+    adjlist_init_stats(&stats);
+    if ( gen_is_spec(argv[1]) ) {
+        d = gen_from_spec(argv[1], &is_undirected, 0);
+        g = csr_build(d->nvertices, d->narcs, d->src, d->dst, d->weight,
+                      &stats, 1, 0);
+        dimacs_destroy(d);
+    } else {
+        g = csr_read(argv[1], &stats, 1);
+    }
+    el = edgelist_create_csr(g);
+    sorted = edgelist_create_csr(g);
+
+    // Sort-then-scan reference
+    timer_clear(&t_kruskal);
+    timer_start(&t_kruskal);
+    kruskal_init_csr(sorted, g, &uf, &membership);
+    kruskal_sort_edges(sorted);
+    kruskal(sorted, uf, membership);
+    timer_stop(&t_kruskal);
+    uf_destroy(uf);
+
+    // Position in the edge list of each sorted edge
+    order = (eid_t*)malloc(el->nedges * sizeof(eid_t));
+    for ( e = 0; e < el->nedges; e++ )
+        order[e] = e;
+    order_edges = el->edge_array;
+    qsort(order, el->nedges, sizeof(eid_t), order_compare);
+    for ( e = 0; e < el->nedges; e++ )
+        assert(memcmp(&sorted->edge_array[e], &el->edge_array[order[e]],
+                      sizeof(edge_t)) == 0);
+
+    timer_clear(&t_filter);
+    for ( k = 0; k < 2; k++ ) {
+        kruskal_init_csr(el, g, &uf, &fk_membership);
+        if ( k )
+            timer_start(&t_filter);
+        filter_kruskal(el, uf, fk_membership, k ? nthreads : 1);
+        if ( k )
+            timer_stop(&t_filter);
+
+        // The very same edges
+        for ( e = 0; e < el->nedges; e++ )
+            assert(!membership[e] == !fk_membership[order[e]]);
+        kruskal_destroy_csr(g, uf, fk_membership);
+    }
+
+    hz = timer_read_hz();
+    fprintf(stdout, "%" PRIeid " edges: kruskal (sort and scan) %lf s, "
+                    "filter-kruskal %lf s (%d threads)\n",
+            el->nedges, timer_total(&t_kruskal) / hz,
+            timer_total(&t_filter) / hz, nthreads);
+
+    free(order);
+    free(membership);
+    edgelist_destroy(sorted);
+    edgelist_destroy(el);
+    csr_destroy(g);
+
+    return 0;
+}
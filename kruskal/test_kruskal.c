@@ -10,6 +10,12 @@
 
 #include "graph/graph.h"
 #include "graph/adjlist.h"
+#include "graph/csr.h"
+#include "graph/csr_file.h"
+#include "graph/dimacs.h"
+#include "graph/generators.h"
+#include "graph/reorder.h"
+#include "filter_kruskal.h"
 #include "kruskal.h"
 
 #ifdef PROFILE
@@ -19,29 +25,45 @@
 int main(int argc, char **argv) 
 {
     unsigned int *edge_membership, 
-                 e,
-                 is_undirected, 
-                 msf_edge_count = 0;
-    int next_option, print_flag;
+                 is_undirected;
+    eid_t e, msf_edge_count = 0;
+    vid_t v1, v2;
+    reorder_method_t reorder_method = REORDER_NONE;
+    reorder_t *r = NULL;
+    int gen_undirected;
+    dimacs_t *d;
+    int next_option, print_flag, csr_flag, filter_flag, nthreads;
     char graphfile[256];
     adjlist_stats_t stats;
     edgelist_t *el;
-    adjlist_t *al;
-    forest_node_t **fnode_array;
+    adjlist_t *al = NULL;
+    csr_t *g = NULL;
+    uf_t *uf;
 
     if ( argc == 1 ) {
-        printf("Usage: ./kruskal --graph <graphfile>\n"
+        printf("Usage: ./kruskal --graph <graphfile|generator spec>\n"
+                "\t\t --csr (implied for binary snapshots)\n"
+                "\t\t --reorder <none|rcm|degree|bfs> (implies --csr)\n"
+                "\t\t --filter (Filter-Kruskal, on the unsorted edges)\n"
+                "\t\t --nthreads <nthreads>\n"
                 "\t\t --print\n");
         exit(EXIT_FAILURE);
     }
 
     print_flag = 0;
+    csr_flag = 0;
+    filter_flag = 0;
+    nthreads = 0;
 
     /* getopt stuff */
-    const char* short_options = "g:p";
+    const char* short_options = "g:r:n:pCF";
     const struct option long_options[]={
         {"graph", 1, NULL, 'g'},
         {"print", 0, NULL, 'p'},
+        {"csr", 0, NULL, 'C'},
+        {"reorder", 1, NULL, 'r'},
+        {"filter", 0, NULL, 'F'},
+        {"nthreads", 1, NULL, 'n'},
         {NULL, 0, NULL, 0}
     };
 
@@ -53,6 +75,24 @@ int main(int argc, char **argv)
                 print_flag = 1;
                 break;
 
+            case 'C':
+                csr_flag = 1;
+                break;
+
+            case 'F':
+                filter_flag = 1;
+                break;
+
+            case 'n':
+                nthreads = atoi(optarg);
+                break;
+
+            case 'r':
+                reorder_method = reorder_parse(optarg);
+                if ( reorder_method != REORDER_NONE )
+                    csr_flag = 1;
+                break;
+
             case 'g':
                 sprintf(graphfile, "%s", optarg);
                 break;
@@ -70,17 +110,48 @@ int main(int argc, char **argv)
 
     } while ( next_option != -1 );
 
-    // Init adjacency list
+    // Init adjacency list (or CSR graph)
     adjlist_init_stats(&stats);
     is_undirected = 1;
-    al = adjlist_read(graphfile, &stats, is_undirected);
+    if ( csr_is_binary(graphfile) ) {
+        csr_flag = 1;
+        g = csr_mmap(graphfile);
+    } else if ( gen_is_spec(graphfile) ) {
+        // Synthetic graph, built in memory
+        d = gen_from_spec(graphfile, &gen_undirected, 0);
+        if ( csr_flag )
+            g = csr_build(d->nvertices, d->narcs, d->src, d->dst, d->weight,
+                          &stats, is_undirected, 0);
+        else
+            al = adjlist_build(d->nvertices, d->narcs, d->src, d->dst, 
+                               d->weight, &stats, is_undirected, 0);
+        dimacs_destroy(d);
+    } else if ( csr_flag )
+        g = csr_read(graphfile, &stats, is_undirected);
+    else
+        al = adjlist_read(graphfile, &stats, is_undirected);
     fprintf(stdout, "Read graph\n\n");
 
+    // Relabel vertices for locality; MSF edges are printed in 
+    // original ids
+    if ( reorder_method != REORDER_NONE ) {
+        csr_t *h;
+        r = reorder_compute(g, reorder_method);
+        h = csr_permute(g, r);
+        csr_destroy(g);
+        g = h;
+    }
+
     // Create edge list from adjacency list
-    el = edgelist_create(al);
-    
-    kruskal_init(el, al, &fnode_array, &edge_membership);
-    kruskal_sort_edges(el);
+    if ( csr_flag ) {
+        el = edgelist_create_csr(g);
+        kruskal_init_csr(el, g, &uf, &edge_membership);
+    } else {
+        el = edgelist_create(al);
+        kruskal_init(el, al, &uf, &edge_membership);
+    }
+    if ( !filter_flag )
+        kruskal_sort_edges(el);
 
 #ifdef PROFILE
     tsctimer_t tim;
@@ -88,7 +159,10 @@ int main(int argc, char **argv)
     timer_start(&tim);
 #endif
 
-    kruskal(el, fnode_array, edge_membership);
+    if ( filter_flag )
+        filter_kruskal(el, uf, edge_membership, nthreads);
+    else
+        kruskal(el, uf, edge_membership);
 
 #ifdef PROFILE
     timer_stop(&tim);
@@ -109,20 +183,35 @@ int main(int argc, char **argv)
             msf_weight += el->edge_array[e].weight;
             msf_edge_count++;
             if ( print_flag ) {
-                fprintf(stdout, "(%u,%u) [%.2f] \n", 
-                        el->edge_array[e].vertex1,  
-                        el->edge_array[e].vertex2,  
-                        el->edge_array[e].weight);
+                v1 = el->edge_array[e].vertex1;
+                v2 = el->edge_array[e].vertex2;
+                if ( r ) {
+                    v1 = r->inv[el->edge_array[e].vertex1];
+                    v2 = r->inv[el->edge_array[e].vertex2];
+                    if ( v1 > v2 ) {
+                        v1 = v2;
+                        v2 = r->inv[el->edge_array[e].vertex1];
+                    }
+                }
+                fprintf(stdout, "(%" PRIvid ",%" PRIvid ") [%.2f] \n", 
+                        v1, v2, el->edge_array[e].weight);
             }
         }
     }
 
     fprintf(stdout, "Total MSF weight: %f\n", msf_weight);
-    fprintf(stdout, "Total MSF edges: %d\n", msf_edge_count);
+    fprintf(stdout, "Total MSF edges: %" PRIeid "\n", msf_edge_count);
 
-    kruskal_destroy(al, fnode_array, edge_membership);
     edgelist_destroy(el);
-    adjlist_destroy(al);
+    if ( r )
+        reorder_destroy(r);
+    if ( csr_flag ) {
+        kruskal_destroy_csr(g, uf, edge_membership);
+        csr_destroy(g);
+    } else {
+        kruskal_destroy(al, uf, edge_membership);
+        adjlist_destroy(al);
+    }
 
     return 0;
 }
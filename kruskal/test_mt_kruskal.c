@@ -14,6 +14,10 @@
 
 #include "graph/graph.h"
 #include "graph/adjlist.h"
+#include "graph/csr.h"
+#include "graph/csr_file.h"
+#include "graph/dimacs.h"
+#include "graph/generators.h"
 #include "kruskal.h"
 #include "util/tsc_x86_64.h"
 #include "mt_kruskal.h"
@@ -26,7 +30,8 @@ tsctimer_t tim;
 adjlist_stats_t stats;
 edgelist_t *el;
 adjlist_t *al;
-forest_node_t **fnode_array;
+csr_t *g;
+uf_t *vertex_sets;
 unsigned int *edge_membership; 
 char *edge_color_main;
 char *edge_color_helper;
@@ -35,11 +40,12 @@ int nthreads;
 
 void touch_structures(edgelist_t *_el,
                              adjlist_t *_al,
-                             forest_node_t **_farray,
+                             uf_t *_sets,
                              char *_edge_color_main,
                              char *_edge_color_helper)
 {
-    unsigned int e, v;
+    eid_t e;
+    vid_t v;
 
     for ( e = 0; e < _el->nedges; e++ ) {
         _edge_color_main[e] += 0;
@@ -47,8 +53,10 @@ void touch_structures(edgelist_t *_el,
         _el->edge_array[e].weight += 0.0;
     }
 
-    for ( v = 0; v < al->nvertices; v++ ) 
-        _farray[v]->rank += 0;
+    for ( v = 0; v < _el->nvertices; v++ ) {
+        _sets->parent[v] += 0;
+        _sets->rank[v] += 0;
+    }
 }
                              
 
@@ -59,13 +67,13 @@ int main(int argc, char **argv)
     pthread_attr_t *attr;
     procmap_t *pi;
     unsigned long llc_level, llc_bytes;
-    int p, c, t, i, e, maxthreads, 
-        is_undirected, mapping,
-        msf_edge_count = 0;
+    int p, c, t, i, maxthreads, 
+        is_undirected, mapping;
+    eid_t e, msf_edge_count = 0;
     char graphfile[256];
 
     if ( argc < 4 ) {
-        fprintf(stderr, "Usage: %s <graphfile> <maxthreads> "
+        fprintf(stderr, "Usage: %s <graphfile|generator spec> <maxthreads> "
                         "<mapping= 0:cpt, 1:pct> \n", argv[0]);
         exit(EXIT_FAILURE);
     }
@@ -86,7 +94,8 @@ int main(int argc, char **argv)
 
   
     printf("Size of edge_t: %d\n", sizeof(edge_t));
-    printf("Size of forest_node_t: %d\n", sizeof(forest_node_t));
+    printf("Disjoint sets bytes per vertex: %d\n", 
+           (int)(sizeof(vid_t) + sizeof(uint8_t)));
 
 
 
@@ -136,14 +145,25 @@ int main(int argc, char **argv)
     // will run on later, before any allocations.
     sched_setaffinity(getpid(), sizeof(cpusets[0]), &cpusets[0]);
 
-    // Init adjacency list
+    // Init adjacency list, or map a binary CSR snapshot
     adjlist_init_stats(&stats);
     is_undirected = 1;
-    al = adjlist_read(graphfile, &stats, is_undirected);
+    if ( csr_is_binary(graphfile) ) {
+        g = csr_mmap(graphfile);
+    } else if ( gen_is_spec(graphfile) ) {
+        // Synthetic graph, generated and built with all threads
+        int gen_undirected;
+        dimacs_t *d = gen_from_spec(graphfile, &gen_undirected, maxthreads);
+        g = csr_build(d->nvertices, d->narcs, d->src, d->dst, d->weight,
+                      &stats, is_undirected, maxthreads);
+        dimacs_destroy(d);
+    } else
+        al = adjlist_read(graphfile, &stats, is_undirected);
     fprintf(stdout, "Read graph\n\n");
 
-    // Create edge list from adjacency list
-    el = edgelist_create(al);
+    // Create edge list from adjacency list, using all threads
+    el = g ? edgelist_create_csr_mt(g, maxthreads) 
+           : edgelist_create_mt(al, maxthreads);
     // Sort edge list
     kruskal_sort_edges(el); 
 
@@ -153,7 +173,10 @@ int main(int argc, char **argv)
                         nthreads, graphfile, mapping == 0 ? "cpt":"pct");
   
         // Perform initializations 
-        kruskal_init(el, al, &fnode_array, &edge_membership);
+        if ( g )
+            kruskal_init_csr(el, g, &vertex_sets, &edge_membership);
+        else
+            kruskal_init(el, al, &vertex_sets, &edge_membership);
         kruskal_helper_init(el, &edge_color_main, &edge_color_helper);
         
         flush_caches(pi->num_cpus, llc_bytes);
@@ -168,7 +191,7 @@ int main(int argc, char **argv)
 
         // Create threads
         assert(el->nedges > nthreads);
-        int chunk_size = el->nedges / nthreads;
+        eid_t chunk_size = el->nedges / nthreads;
         
         for ( i = 0; i < nthreads; i++ ) {
             if ( i < 1 ) {
@@ -207,7 +230,7 @@ int main(int argc, char **argv)
             }
         }
         fprintf(stdout, " msf_weight:%.0f", msf_weight);
-        fprintf(stdout, " msf_edges:%d\n", msf_edge_count);
+        fprintf(stdout, " msf_edges:%" PRIeid "\n", msf_edge_count);
 
         // clean-up things
         pthread_barrier_destroy(&bar);
@@ -215,14 +238,20 @@ int main(int argc, char **argv)
         free(targs);
         free(attr);
 
-        kruskal_destroy(al, fnode_array, edge_membership);
+        if ( g )
+            kruskal_destroy_csr(g, vertex_sets, edge_membership);
+        else
+            kruskal_destroy(al, vertex_sets, edge_membership);
         kruskal_helper_destroy(edge_color_main, edge_color_helper);
     }
     
     procmap_destroy(pi); 
     
     edgelist_destroy(el);
-    adjlist_destroy(al);
+    if ( g )
+        csr_destroy(g);
+    else
+        adjlist_destroy(al);
 
     return 0;
 }
@@ -0,0 +1,129 @@
+/**
+ * @file
+ * Radix heap function definitions
+ */ 
+
+#include "radix_heap.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * Allocates an empty radix heap
+ * @return pointer to the heap 
+ */ 
+rheap_t* rh_create(void)
+{
+    rheap_t *heap = (rheap_t*)calloc(1, sizeof(rheap_t));
+    if ( !heap ) {
+        fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+
+    return heap;
+}
+
+/**
+ * Deallocates heap
+ * @param heap pointer to heap
+ */ 
+void rh_destroy(rheap_t *heap)
+{
+    int i;
+
+    for ( i = 0; i < RH_NBUCKETS; i++ )
+        free(heap->buckets[i].entries);
+    free(heap);
+}
+
+/**
+ * Empties the heap and resets the last popped key to 0, keeping the
+ * bucket memory for reuse
+ * @param heap pointer to heap
+ */ 
+void rh_clear(rheap_t *heap)
+{
+    int i;
+
+    for ( i = 0; i < RH_NBUCKETS; i++ )
+        heap->buckets[i].size = 0;
+    heap->size = 0;
+    heap->last = 0;
+}
+
+/**
+ * Appends an entry to a bucket
+ */ 
+static inline void rh_bucket_append(rh_bucket_t *b, rh_key_t key, vid_t id)
+{
+    if ( b->size == b->capacity ) {
+        b->capacity = b->capacity ? 2 * b->capacity : 16;
+        b->entries = (rh_entry_t*)realloc(b->entries, 
+                                          b->capacity * sizeof(rh_entry_t));
+        if ( !b->entries ) {
+            fprintf(stderr, "%s: Allocation error\n", __FUNCTION__);
+            exit(EXIT_FAILURE);
+        }
+    }
+    b->entries[b->size].key = key;
+    b->entries[b->size].id = id;
+    b->size++;
+}
+
+/**
+ * Inserts an entry
+ * @param heap pointer to heap
+ * @param key entry key (must be >= the last popped key)
+ * @param id entry data
+ */ 
+void rh_push(rheap_t *heap, rh_key_t key, vid_t id)
+{
+    if ( key < heap->last ) {
+        fprintf(stderr, "Key (%u) is smaller than last popped key (%u)\n", 
+                key, heap->last);
+        exit(EXIT_FAILURE);
+    }
+
+    rh_bucket_append(&heap->buckets[rh_bucket(heap->last, key)], key, id);
+    heap->size++;
+}
+
+/**
+ * Removes an entry with minimum key
+ * @param heap pointer to heap (must not be empty)
+ * @param key key of the removed entry (output)
+ * @return data of the removed entry
+ */ 
+vid_t rh_pop(rheap_t *heap, rh_key_t *key)
+{
+    int i;
+    eid_t j;
+    rh_key_t min;
+    rh_bucket_t *b;
+
+    // Refill bucket 0 from the first non-empty bucket: its minimum 
+    // becomes the last key, and its entries all fall into lower buckets
+    if ( heap->buckets[0].size == 0 ) {
+        for ( i = 1; heap->buckets[i].size == 0; i++ )
+            ;
+        b = &heap->buckets[i];
+
+        min = b->entries[0].key;
+        for ( j = 1; j < b->size; j++ )
+            if ( b->entries[j].key < min )
+                min = b->entries[j].key;
+        heap->last = min;
+
+        for ( j = 0; j < b->size; j++ )
+            rh_bucket_append(&heap->buckets[rh_bucket(min, b->entries[j].key)],
+                             b->entries[j].key, b->entries[j].id);
+        b->size = 0;
+    }
+
+    b = &heap->buckets[0];
+    b->size--;
+    heap->size--;
+    *key = b->entries[b->size].key;
+
+    return b->entries[b->size].id;
+}
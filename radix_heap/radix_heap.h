@@ -0,0 +1,118 @@
+/**
+ * @file
+ * Radix heap type definitions and function declarations.
+ *
+ * Monotone priority queue: a key pushed must not be smaller than the
+ * last key popped, as in Dijkstra's algorithm with non-negative 
+ * weights. Entries are kept in buckets by the highest bit in which 
+ * their key differs from the last popped key; bucket 0 holds keys 
+ * equal to it. Popping from an empty bucket 0 takes the minimum of the 
+ * first non-empty bucket as the new last key and spreads that bucket 
+ * over the lower ones, so every entry moves at most 32 times.
+ *
+ * There is no decrease-key: a key is lowered by pushing the id again, 
+ * and stale entries are skipped by the caller.
+ *
+ * Keys are unsigned 32-bit integers. Non-negative floats (including 
+ * INFINITY) are ordered like their bit patterns, so float keys are 
+ * pushed through rh_float_key() and read back with rh_key_float().
+ */ 
+
+#ifndef RHEAP_H_
+#define RHEAP_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include "graph/graph.h"
+
+/**
+ * Key data type
+ */ 
+typedef uint32_t rh_key_t;
+
+/**
+ * Number of buckets: one for keys equal to the last popped key, and 
+ * one per differing bit
+ */ 
+#define RH_NBUCKETS 33
+
+/**
+ * Heap entry
+ */ 
+typedef struct rh_entry_st {
+    rh_key_t key; //!< entry key
+    vid_t id; //!< data associated with the entry (not unique)
+} rh_entry_t;
+
+/**
+ * Bucket of entries, in no particular order
+ */ 
+typedef struct rh_bucket_st {
+    rh_entry_t *entries; //!< entries
+    eid_t size; //!< number of entries
+    eid_t capacity; //!< allocated entries
+} rh_bucket_t;
+
+/**
+ * Heap data structure
+ */ 
+typedef struct rheap_st {
+    rh_key_t last; //!< last popped key
+    eid_t size; //!< number of entries in all buckets
+    rh_bucket_t buckets[RH_NBUCKETS]; //!< buckets
+} rheap_t;
+
+/**
+ * Converts a non-negative float to an order-preserving key
+ * @param f non-negative float (0 and INFINITY included)
+ * @return key
+ */ 
+static inline rh_key_t rh_float_key(float f)
+{
+    rh_key_t k;
+    f += 0.0f; // -0 -> +0
+    memcpy(&k, &f, sizeof(k));
+    return k;
+}
+
+/**
+ * Converts a key made by rh_float_key() back to a float
+ * @param k key
+ * @return float
+ */ 
+static inline float rh_key_float(rh_key_t k)
+{
+    float f;
+    memcpy(&f, &k, sizeof(f));
+    return f;
+}
+
+/**
+ * Returns the bucket of a key
+ * @param last last popped key
+ * @param key key (>= last)
+ * @return bucket index
+ */ 
+static inline int rh_bucket(rh_key_t last, rh_key_t key)
+{
+    return key == last ? 0 : 32 - __builtin_clz(key ^ last);
+}
+
+/**
+ * Returns whether the heap is empty
+ * @param heap pointer to heap
+ * @return 1 if empty, 0 otherwise
+ */ 
+static inline int rh_empty(const rheap_t *heap)
+{
+    return heap->size == 0;
+}
+
+extern rheap_t* rh_create(void);
+extern void rh_destroy(rheap_t *heap);
+extern void rh_clear(rheap_t *heap);
+extern void rh_push(rheap_t *heap, rh_key_t key, vid_t id);
+extern vid_t rh_pop(rheap_t *heap, rh_key_t *key);
+
+#endif
@@ -0,0 +1,56 @@
+/**
+ * @file
+ * Radix heap test program
+ */ 
+
+#include <assert.h>
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "radix_heap.h"
+
+#define N 100000
+
+int main(int argc, char **argv)
+{
+    rheap_t *heap = rh_create();
+    rh_key_t key, prev;
+    vid_t id, n;
+    float f, fprev;
+
+    // Integer keys, interleaving pops with monotone pushes
+    srand(1);
+    for ( id = 0; id < N / 2; id++ )
+        rh_push(heap, rand() % 1000, id);
+    prev = 0;
+    for ( n = 0; !rh_empty(heap); n++ ) {
+        rh_pop(heap, &key);
+        assert(key >= prev);
+        prev = key;
+        if ( n < N / 2 )
+            rh_push(heap, key + rand() % 100000, n);
+    }
+    assert(n == N);
+
+    // Float keys, INFINITY included
+    rh_clear(heap);
+    for ( id = 0; id < N; id++ ) {
+        f = id % 10 == 0 ? INFINITY : (float)rand() / RAND_MAX * 1000;
+        rh_push(heap, rh_float_key(f), id);
+    }
+    fprev = 0;
+    for ( n = 0; !rh_empty(heap); n++ ) {
+        rh_pop(heap, &key);
+        f = rh_key_float(key);
+        assert(f >= fprev);
+        fprev = f;
+    }
+    assert(n == N && fprev == INFINITY);
+    assert(rh_float_key(-0.0f) == rh_float_key(0.0f));
+
+    fprintf(stdout, "Radix heap: OK\n");
+
+    rh_destroy(heap);
+
+    return 0;
+}